@@ -49,6 +49,8 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_BATCH_DELAY = "batch_delay"
+CONF_BINARY_LOGS = "binary_logs"
 
 
 def validate_encryption_key(value):
@@ -100,6 +102,11 @@ CONFIG_SCHEMA = cv.All(
                     cv.Required(CONF_KEY): validate_encryption_key,
                 }
             ),
+            cv.Optional(CONF_BATCH_DELAY): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=cv.TimePeriod(milliseconds=65535)),
+            ),
+            cv.Optional(CONF_BINARY_LOGS, default=False): cv.boolean,
             cv.Optional(CONF_ON_CLIENT_CONNECTED): automation.validate_automation(
                 single=True
             ),
@@ -120,6 +127,12 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    if CONF_BATCH_DELAY in config:
+        cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
+        cg.add_define("USE_API_BATCHING")
+    if config[CONF_BINARY_LOGS]:
+        cg.add_define("USE_API_BINARY_LOGS")
+        cg.add_define("USE_LOGGER_RAW_CALLBACK")
 
     for conf in config.get(CONF_ACTIONS, []):
         template_args = []
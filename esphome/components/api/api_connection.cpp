@@ -9,6 +9,10 @@
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
 
+#ifdef USE_API_BINARY_LOGS
+#include "binary_log.h"
+#endif
+
 #ifdef USE_DEEP_SLEEP
 #include "esphome/components/deep_sleep/deep_sleep_component.h"
 #endif
@@ -27,6 +31,10 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+#ifdef USE_API_BATCHING
+// Flush early once a batch fills about one TCP segment (lwIP default MSS)
+static const size_t API_MAX_BATCH_SIZE = 1436;
+#endif
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
@@ -79,6 +87,13 @@ void APIConnection::loop() {
     ESP_LOGW(TAG, "%s: Network unavailable, disconnecting", this->client_combined_info_.c_str());
     return;
   }
+#ifdef USE_API_BATCHING
+  if (this->helper_->is_batching() &&
+      (this->next_close_ || millis() - this->batch_start_ >= this->parent_->get_batch_delay())) {
+    if (!this->flush_batch_())
+      return;
+  }
+#endif
   if (this->next_close_) {
     // requested a disconnect
     this->helper_->close();
@@ -116,8 +131,16 @@ void APIConnection::loop() {
       return;
   }
 
+  if (this->state_resync_pending_ && !this->initial_state_iterator_.is_running() &&
+      this->helper_->can_write_without_blocking()) {
+    this->state_resync_pending_ = false;
+    this->initial_state_iterator_.begin();
+  }
   this->list_entities_iterator_.advance();
+  // the iterator retries its own dropped messages
+  this->sending_initial_states_ = true;
   this->initial_state_iterator_.advance();
+  this->sending_initial_states_ = false;
 
   static uint32_t keepalive = 60000;
   static uint8_t max_ping_retries = 60;
@@ -152,7 +175,8 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    // key (1 + 4) + data (1 + 2 + to_send) + done (1 + 1)
+    auto buffer = this->create_buffer(10 + to_send);
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
     // bytes data = 2;
@@ -1160,6 +1184,31 @@ BluetoothConnectionsFreeResponse APIConnection::subscribe_bluetooth_connections_
 }
 #endif
 
+#ifdef USE_COMPONENT_PROFILER
+ComponentProfileResponse APIConnection::component_profile(const ComponentProfileRequest &msg) {
+  ComponentProfileResponse resp;
+  const auto &components = App.get_components();
+  resp.components.reserve(components.size());
+  for (auto *component : components) {
+    auto &profile = component->get_profile();
+    ComponentProfile entry;
+    entry.source = component->get_component_source();
+    entry.loop_count = profile.loop_count;
+    entry.loop_total_us = profile.loop_total_us;
+    entry.loop_max_us = profile.loop_max_us;
+    entry.loop_p99_us = profile.loop_percentile_us(99);
+    entry.scheduler_count = profile.scheduler_count;
+    entry.scheduler_total_us = profile.scheduler_total_us;
+    entry.scheduler_max_us = profile.scheduler_max_us;
+    entry.setup_us = profile.setup_us;
+    resp.components.push_back(std::move(entry));
+    if (msg.reset)
+      profile.reset();
+  }
+  return resp;
+}
+#endif
+
 #ifdef USE_VOICE_ASSISTANT
 void APIConnection::subscribe_voice_assistant(const SubscribeVoiceAssistantRequest &msg) {
   if (voice_assistant::global_voice_assistant != nullptr) {
@@ -1408,15 +1457,66 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
     return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  const size_t line_len = strlen(line);
+  uint32_t msg_size = 0;
+  ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(level));
+  msg_size += 1 + ProtoSize::varint(static_cast<uint32_t>(line_len)) + line_len;
+  auto buffer = this->create_buffer(msg_size);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_len);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
 
+#ifdef USE_API_BINARY_LOGS
+bool APIConnection::send_binary_log_message(int level, uint16_t call_site_id, const char *tag, int line,
+                                            const char *format, const uint8_t *args, size_t args_len) {
+  if (this->log_subscription_ < level)
+    return false;
+  const uint16_t id = call_site_id;
+  const bool send_call_site = id > this->sent_log_call_sites_.size() || !this->sent_log_call_sites_[id - 1];
+
+  const size_t format_len = send_call_site ? strlen(format) : 0;
+  const size_t tag_len = send_call_site ? strlen(tag) : 0;
+  uint32_t msg_size = 0;
+  ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(level));
+  ProtoSize::add_uint32_field(msg_size, 1, id);
+  if (send_call_site) {
+    msg_size += 1 + ProtoSize::varint(static_cast<uint32_t>(format_len)) + format_len;
+    msg_size += 1 + ProtoSize::varint(static_cast<uint32_t>(tag_len)) + tag_len;
+    ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(line));
+  }
+  msg_size += 1 + ProtoSize::varint(static_cast<uint32_t>(args_len)) + args_len;
+
+  auto buffer = this->create_buffer(msg_size);
+  // LogLevel level = 1;
+  buffer.encode_uint32(1, static_cast<uint32_t>(level));
+  // uint32 format_id = 5;
+  buffer.encode_uint32(5, id);
+  if (send_call_site) {
+    // string format = 6;
+    buffer.encode_string(6, format, format_len, true);
+    // string tag = 7;
+    buffer.encode_string(7, tag, tag_len, true);
+    // uint32 line = 8;
+    buffer.encode_uint32(8, static_cast<uint32_t>(line));
+  }
+  // bytes args = 9;
+  buffer.encode_bytes(9, args, args_len, true);
+  // SubscribeLogsResponse - 29
+  if (!this->send_buffer(buffer, 29))
+    return false;
+  if (send_call_site) {
+    if (this->sent_log_call_sites_.size() < id)
+      this->sent_log_call_sites_.resize(id, false);
+    this->sent_log_call_sites_[id - 1] = true;
+  }
+  return true;
+}
+#endif
+
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
   this->client_info_ = msg.client_info;
   this->client_peername_ = this->helper_->getpeername();
@@ -1528,7 +1628,13 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
                api_error_to_str(err), errno);
       return false;
     }
-    if (!this->helper_->can_write_without_blocking()) {
+    if (!this->helper_->is_ready_to_send()) {
+      delay(0);
+      return false;
+    }
+    // Other messages may only fill half of the send queue, the rest is kept for state updates
+    if (!this->is_state_response(message_type) &&
+        this->helper_->get_tx_queue_size() >= APIFrameHelper::MAX_TX_QUEUE_SIZE / 2) {
       // SubscribeLogsResponse
       if (message_type != 29) {
         ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
@@ -1538,9 +1644,19 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
+#ifdef USE_API_BATCHING
+  if (!this->helper_->is_batching()) {
+    this->helper_->begin_batch();
+    this->batch_start_ = millis();
+  }
+#endif
   APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
-  if (err == APIError::WOULD_BLOCK)
+  if (err == APIError::WOULD_BLOCK) {
+    // send queue is full
+    if (this->is_state_response(message_type))
+      this->on_message_dropped_();
     return false;
+  }
   if (err != APIError::OK) {
     on_fatal_error();
     if (err == APIError::SOCKET_WRITE_FAILED && errno == ECONNRESET) {
@@ -1551,9 +1667,39 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
     return false;
   }
+#ifdef USE_API_BATCHING
+  if (this->helper_->get_batch_size() >= API_MAX_BATCH_SIZE)
+    return this->flush_batch_();
+#endif
   // Do not set last_traffic_ on send
   return true;
 }
+#ifdef USE_API_BATCHING
+bool APIConnection::flush_batch_() {
+  const uint16_t count = this->helper_->get_batch_count();
+  const size_t size = this->helper_->get_batch_size();
+  APIError err = this->helper_->flush_batch();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Batch write failed %s errno=%d", this->client_combined_info_.c_str(), api_error_to_str(err),
+             errno);
+    return false;
+  }
+  if (count != 0) {
+    ESP_LOGVV(TAG, "%s: Sent %u messages (%u bytes) in one write", this->client_combined_info_.c_str(), count,
+              (unsigned) size);
+    this->parent_->record_batch(count);
+  }
+  return true;
+}
+#endif
+void APIConnection::on_message_dropped_() {
+  // A state update did not fit in the send queue. Rather than queueing every update while the client can't keep up,
+  // send the current state of all entities once the send queue has drained. That way superseded updates are never
+  // sent.
+  if (this->state_subscription_ && !this->sending_initial_states_)
+    this->state_resync_pending_ = true;
+}
 void APIConnection::on_unauthenticated_access() {
   this->on_fatal_error();
   ESP_LOGD(TAG, "%s: tried to access without authentication.", this->client_combined_info_.c_str());
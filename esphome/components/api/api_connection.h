@@ -118,6 +118,12 @@ class APIConnection : public APIServerConnection {
   void media_player_command(const MediaPlayerCommandRequest &msg) override;
 #endif
   bool send_log_message(int level, const char *tag, const char *line);
+#ifdef USE_API_BINARY_LOGS
+  bool is_binary_log_subscriber() const { return this->log_binary_; }
+  /// Send a log message as its call site id and the arguments encoded by encode_log_args().
+  bool send_binary_log_message(int level, uint16_t call_site_id, const char *tag, int line, const char *format,
+                               const uint8_t *args, size_t args_len);
+#endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
       return;
@@ -139,6 +145,9 @@ class APIConnection : public APIServerConnection {
       const SubscribeBluetoothConnectionsFreeRequest &msg) override;
 
 #endif
+#ifdef USE_COMPONENT_PROFILER
+  ComponentProfileResponse component_profile(const ComponentProfileRequest &msg) override;
+#endif
 #ifdef USE_HOMEASSISTANT_TIME
   void send_time_request() {
     GetTimeRequest req;
@@ -197,6 +206,10 @@ class APIConnection : public APIServerConnection {
   }
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
+#ifdef USE_API_BINARY_LOGS
+    this->log_binary_ = msg.binary;
+    this->sent_log_call_sites_.clear();
+#endif
     if (msg.dump_config)
       App.schedule_dump_config();
   }
@@ -217,9 +230,10 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
     this->proto_write_buffer_.clear();
+    this->proto_write_buffer_.reserve(reserve_size);
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -230,6 +244,11 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  void on_message_dropped_();
+#ifdef USE_API_BATCHING
+  /// Write the batched messages to the socket, returns false if the connection failed.
+  bool flush_batch_();
+#endif
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -254,10 +273,20 @@ class APIConnection : public APIServerConnection {
 #endif
 
   bool state_subscription_{false};
+  bool state_resync_pending_{false};
+  bool sending_initial_states_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
+#ifdef USE_API_BINARY_LOGS
+  bool log_binary_{false};
+  /// Call sites whose format, tag and line this client has received
+  std::vector<bool> sent_log_call_sites_;
+#endif
   uint32_t last_traffic_;
   uint32_t next_ping_retry_{0};
   uint8_t ping_retries_{0};
+#ifdef USE_API_BATCHING
+  uint32_t batch_start_{0};
+#endif
   bool sent_ping_{false};
   bool service_call_subscription_{false};
   bool next_close_ = false;
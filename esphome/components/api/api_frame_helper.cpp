@@ -76,6 +76,73 @@ const char *api_error_to_str(APIError err) {
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
 
+bool APIFrameHelper::batch_raw_(const struct iovec *iov, int iovcnt) {
+  if (!this->batching_)
+    return false;
+  for (int i = 0; i < iovcnt; i++) {
+    this->batch_buf_.insert(this->batch_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
+                            reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+  }
+  this->batch_count_++;
+  return true;
+}
+APIError APIFrameHelper::flush_batch() {
+  this->batching_ = false;
+  if (this->batch_buf_.empty())
+    return APIError::OK;
+
+  struct iovec iov;
+  iov.iov_base = this->batch_buf_.data();
+  iov.iov_len = this->batch_buf_.size();
+  APIError err = this->write_raw_(&iov, 1);
+  // keep the capacity around for the next batch
+  this->batch_buf_.clear();
+  this->batch_count_ = 0;
+  return err;
+}
+void APIFrameHelper::enqueue_tx_(const uint8_t *data, size_t len) {
+  this->tx_buf_size_ += len;
+  if (!this->tx_buf_.empty()) {
+    // append to the last chunk if it has room, to keep the number of iovecs per write low
+    auto &last = this->tx_buf_.back().data;
+    if (last.capacity() - last.size() >= len) {
+      last.insert(last.end(), data, data + len);
+      return;
+    }
+  }
+  SendBuffer buf;
+  if (!this->tx_pool_.empty()) {
+    buf.data = std::move(this->tx_pool_.back());
+    this->tx_pool_.pop_back();
+  }
+  buf.data.assign(data, data + len);
+  this->tx_buf_.push_back(std::move(buf));
+}
+int APIFrameHelper::fill_tx_iov_(struct iovec *iov, int iovcnt) const {
+  int i = 0;
+  for (auto it = this->tx_buf_.begin(); it != this->tx_buf_.end() && i < iovcnt; ++it, ++i) {
+    iov[i].iov_base = const_cast<uint8_t *>(it->data.data() + it->offset);
+    iov[i].iov_len = it->remaining();
+  }
+  return i;
+}
+void APIFrameHelper::consume_tx_(size_t sent) {
+  this->tx_buf_size_ -= sent;
+  while (sent > 0 && !this->tx_buf_.empty()) {
+    SendBuffer &front = this->tx_buf_.front();
+    if (sent < front.remaining()) {
+      front.offset += sent;
+      return;
+    }
+    sent -= front.remaining();
+    if (this->tx_pool_.size() < MAX_TX_POOL) {
+      front.data.clear();
+      this->tx_pool_.push_back(std::move(front.data));
+    }
+    this->tx_buf_.pop_front();
+  }
+}
+
 #ifdef USE_API_NOISE
 static const char *const PROLOGUE_INIT = "NoiseAPIInit";
 
@@ -467,6 +534,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
+bool APINoiseFrameHelper::is_ready_to_send() { return state_ == State::DATA; }
 APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
   int err;
   APIError aerr;
@@ -482,6 +550,10 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   size_t padding = 0;
   size_t msg_len = 4 + payload_len + padding;
   size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
+  if (!this->can_queue_(frame_len)) {
+    // checked before encrypting, a dropped frame would desync the cipher state
+    return APIError::WOULD_BLOCK;
+  }
   auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
   if (tmpbuf == nullptr) {
     HELPER_LOG("Could not allocate for writing packet");
@@ -525,7 +597,9 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    struct iovec iov[MAX_TX_IOV];
+    int iovcnt = this->fill_tx_iov_(iov, MAX_TX_IOV);
+    ssize_t sent = socket_->writev(iov, iovcnt);
     if (sent == -1) {
       if (errno == EWOULDBLOCK || errno == EAGAIN)
         break;
@@ -535,9 +609,7 @@ APIError APINoiseFrameHelper::try_send_tx_buf_() {
     } else if (sent == 0) {
       break;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    this->consume_tx_(sent);
   }
 
   return APIError::OK;
@@ -550,6 +622,8 @@ APIError APINoiseFrameHelper::try_send_tx_buf_() {
 APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
     return APIError::OK;
+  if (this->batch_raw_(iov, iovcnt))
+    return APIError::OK;
   APIError aerr;
 
   size_t total_write_len = 0;
@@ -571,8 +645,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      this->enqueue_tx_(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   }
@@ -581,8 +654,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      this->enqueue_tx_(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   } else if (sent == -1) {
@@ -597,8 +669,8 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
       if (to_consume >= iov[i].iov_len) {
         to_consume -= iov[i].iov_len;
       } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+        this->enqueue_tx_(reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
+                          iov[i].iov_len - to_consume);
         to_consume = 0;
       }
     }
@@ -903,6 +975,7 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
+bool APIPlaintextFrameHelper::is_ready_to_send() { return state_ == State::DATA; }
 APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
@@ -912,6 +985,9 @@ APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *pay
   header.push_back(0x00);
   ProtoVarInt(payload_len).encode(header);
   ProtoVarInt(type).encode(header);
+  if (!this->can_queue_(header.size() + payload_len)) {
+    return APIError::WOULD_BLOCK;
+  }
 
   struct iovec iov[2];
   iov[0].iov_base = &header[0];
@@ -927,7 +1003,9 @@ APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *pay
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    struct iovec iov[MAX_TX_IOV];
+    int iovcnt = this->fill_tx_iov_(iov, MAX_TX_IOV);
+    ssize_t sent = socket_->writev(iov, iovcnt);
     if (is_would_block(sent)) {
       break;
     } else if (sent == -1) {
@@ -935,9 +1013,7 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    this->consume_tx_(sent);
   }
 
   return APIError::OK;
@@ -950,6 +1026,8 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
 APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
     return APIError::OK;
+  if (this->batch_raw_(iov, iovcnt))
+    return APIError::OK;
   APIError aerr;
 
   size_t total_write_len = 0;
@@ -971,8 +1049,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      this->enqueue_tx_(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   }
@@ -981,8 +1058,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      this->enqueue_tx_(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   } else if (sent == -1) {
@@ -997,8 +1073,8 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
       if (to_consume >= iov[i].iov_len) {
         to_consume -= iov[i].iov_len;
       } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+        this->enqueue_tx_(reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
+                          iov[i].iov_len - to_consume);
         to_consume = 0;
       }
     }
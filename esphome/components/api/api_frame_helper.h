@@ -30,6 +30,13 @@ struct PacketBuffer {
   uint8_t data_len;
 };
 
+/// A chunk of data that could not be written to the socket yet.
+struct SendBuffer {
+  std::vector<uint8_t> data;
+  size_t offset{0};  // bytes of data already written
+  size_t remaining() const { return this->data.size() - this->offset; }
+};
+
 enum class APIError : int {
   OK = 0,
   WOULD_BLOCK = 1001,
@@ -64,7 +71,14 @@ class APIFrameHelper {
   virtual APIError init() = 0;
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
+  /// Whether all previously written data has been handed to the socket.
   virtual bool can_write_without_blocking() = 0;
+  /// Whether the handshake is done and write_packet() accepts packets.
+  virtual bool is_ready_to_send() = 0;
+  /** Write a packet, queueing whatever the socket does not accept right away.
+   *
+   * Returns APIError::WOULD_BLOCK without writing anything if the send queue is full.
+   */
   virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
@@ -72,6 +86,50 @@ class APIFrameHelper {
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+
+  /// Start collecting written packets in memory, until flush_batch() sends them with a single socket write.
+  void begin_batch() { this->batching_ = true; }
+  bool is_batching() const { return this->batching_; }
+  /// Number of packets in the current batch.
+  uint16_t get_batch_count() const { return this->batch_count_; }
+  /// Number of bytes in the current batch.
+  size_t get_batch_size() const { return this->batch_buf_.size(); }
+  /// Write all batched packets and stop batching.
+  APIError flush_batch();
+  /// Number of bytes waiting in the send queue, including the current batch.
+  size_t get_tx_queue_size() const { return this->tx_buf_size_ + this->batch_buf_.size(); }
+
+  /// Maximum size of the send queue, write_packet() rejects packets that would grow it beyond this.
+  static const size_t MAX_TX_QUEUE_SIZE = 8192;
+
+ protected:
+  virtual APIError write_raw_(const struct iovec *iov, int iovcnt) = 0;
+  /// Append the data to the current batch, returns false if not batching.
+  bool batch_raw_(const struct iovec *iov, int iovcnt);
+
+  /// Whether \p len more bytes fit in the send queue. The current batch counts, it is queued when flushed.
+  bool can_queue_(size_t len) const {
+    const size_t queued = this->get_tx_queue_size();
+    return queued == 0 || queued + len <= MAX_TX_QUEUE_SIZE;
+  }
+  /// Queue data that could not be written yet.
+  void enqueue_tx_(const uint8_t *data, size_t len);
+  /// Fill \p iov with the queued data, returns the number of entries used.
+  int fill_tx_iov_(struct iovec *iov, int iovcnt) const;
+  /// Remove \p sent bytes from the front of the send queue.
+  void consume_tx_(size_t sent);
+
+  static const int MAX_TX_IOV = 8;
+  static const size_t MAX_TX_POOL = 4;
+
+  bool batching_{false};
+  uint16_t batch_count_{0};
+  std::vector<uint8_t> batch_buf_;
+
+  std::deque<SendBuffer> tx_buf_;
+  size_t tx_buf_size_{0};
+  // Chunks kept around for reuse, so a congested connection does not allocate for every queued packet
+  std::vector<std::vector<uint8_t>> tx_pool_;
 };
 
 #ifdef USE_API_NOISE
@@ -84,6 +142,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
+  bool is_ready_to_send() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
@@ -103,7 +162,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
   APIError write_frame_(const uint8_t *data, size_t len);
-  APIError write_raw_(const struct iovec *iov, int iovcnt);
+  APIError write_raw_(const struct iovec *iov, int iovcnt) override;
   APIError init_handshake_();
   APIError check_handshake_finished_();
   void send_explicit_handshake_reject_(const std::string &reason);
@@ -116,7 +175,6 @@ class APINoiseFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -147,6 +205,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
+  bool is_ready_to_send() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
@@ -164,7 +223,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
 
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
-  APIError write_raw_(const struct iovec *iov, int iovcnt);
+  APIError write_raw_(const struct iovec *iov, int iovcnt) override;
 
   std::unique_ptr<socket::Socket> socket_;
 
@@ -177,8 +236,6 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
-
   enum class State {
     INITIALIZE = 1,
     DATA = 2,
@@ -652,6 +652,42 @@ bool APIServerConnectionBase::send_update_state_response(const UpdateStateRespon
 #endif
 #ifdef USE_UPDATE
 #endif
+#ifdef USE_COMPONENT_PROFILER
+#endif
+#ifdef USE_COMPONENT_PROFILER
+bool APIServerConnectionBase::send_component_profile_response(const ComponentProfileResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_component_profile_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<ComponentProfileResponse>(msg, 125);
+}
+#endif
+bool APIServerConnectionBase::is_state_response(uint32_t msg_type) {
+  switch (msg_type) {
+    case 21:   // BinarySensorStateResponse
+    case 22:   // CoverStateResponse
+    case 23:   // FanStateResponse
+    case 24:   // LightStateResponse
+    case 25:   // SensorStateResponse
+    case 26:   // SwitchStateResponse
+    case 27:   // TextSensorStateResponse
+    case 47:   // ClimateStateResponse
+    case 50:   // NumberStateResponse
+    case 53:   // SelectStateResponse
+    case 59:   // LockStateResponse
+    case 64:   // MediaPlayerStateResponse
+    case 95:   // AlarmControlPanelStateResponse
+    case 98:   // TextStateResponse
+    case 101:  // DateStateResponse
+    case 104:  // TimeStateResponse
+    case 110:  // ValveStateResponse
+    case 113:  // DateTimeStateResponse
+    case 117:  // UpdateStateResponse
+      return true;
+    default:
+      return false;
+  }
+}
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -1191,6 +1227,17 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       ESP_LOGVV(TAG, "on_voice_assistant_set_configuration: %s", msg.dump().c_str());
 #endif
       this->on_voice_assistant_set_configuration(msg);
+#endif
+      break;
+    }
+    case 124: {
+#ifdef USE_COMPONENT_PROFILER
+      ComponentProfileRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_component_profile_request: %s", msg.dump().c_str());
+#endif
+      this->on_component_profile_request(msg);
 #endif
       break;
     }
@@ -1723,6 +1770,22 @@ void APIServerConnection::on_alarm_control_panel_command_request(const AlarmCont
   this->alarm_control_panel_command(msg);
 }
 #endif
+#ifdef USE_COMPONENT_PROFILER
+void APIServerConnection::on_component_profile_request(const ComponentProfileRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  ComponentProfileResponse ret = this->component_profile(msg);
+  if (!this->send_component_profile_response(ret)) {
+    this->on_fatal_error();
+  }
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -2,6 +2,7 @@
 #ifdef USE_API
 #include <cerrno>
 #include "api_connection.h"
+#include "binary_log.h"
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
 #include "esphome/core/defines.h"
@@ -69,8 +70,38 @@ void APIServer::setup() {
 
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
+#ifdef USE_API_BINARY_LOGS
+    logger::global_logger->add_on_raw_log_callback(
+        [this](int level, const char *tag, int line, const char *format, va_list args) {
+          uint16_t call_site_id = 0;
+          for (auto &c : this->clients_) {
+            if (!c->remove_ && c->is_binary_log_subscriber()) {
+              if (call_site_id == 0) {
+                call_site_id = this->get_log_call_site_id(tag, line, format);
+                // out of ids, all clients get the rendered text instead
+                if (call_site_id == 0)
+                  return false;
+                // encoded once for all clients, the buffer keeps its capacity between messages
+                this->log_args_buffer_.clear();
+                encode_log_args(format, args, this->log_args_buffer_);
+              }
+              c->send_binary_log_message(level, call_site_id, tag, line, format, this->log_args_buffer_.data(),
+                                         this->log_args_buffer_.size());
+            }
+          }
+          // binary subscribers skip the rendered text of this message
+          return true;
+        });
+#endif
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
+#ifdef USE_API_BINARY_LOGS
+      const bool binary_sent = logger::global_logger->is_raw_handled();
+#endif
       for (auto &c : this->clients_) {
+#ifdef USE_API_BINARY_LOGS
+        if (binary_sent && c->is_binary_log_subscriber())
+          continue;
+#endif
         if (!c->remove_)
           c->send_log_message(level, tag, message);
       }
@@ -144,6 +175,9 @@ void APIServer::dump_config() {
 #else
   ESP_LOGCONFIG(TAG, "  Using noise encryption: NO");
 #endif
+#ifdef USE_API_BATCHING
+  ESP_LOGCONFIG(TAG, "  Batch delay: %u ms", this->batch_delay_);
+#endif
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
@@ -377,6 +411,39 @@ const std::vector<APIServer::HomeAssistantStateSubscription> &APIServer::get_sta
 }
 uint16_t APIServer::get_port() const { return this->port_; }
 void APIServer::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
+#ifdef USE_API_BINARY_LOGS
+/// FNV-1 hash of a log call site, see fnv1_hash().
+static uint32_t log_call_site_hash(const char *tag, int line, const char *format) {
+  uint32_t hash = 2166136261UL;
+  for (const char *c = tag; *c != '\0'; c++) {
+    hash *= 16777619UL;
+    hash ^= *c;
+  }
+  // separates the tag from the format, so the split between them is part of the hash
+  hash *= 16777619UL;
+  for (const char *c = format; *c != '\0'; c++) {
+    hash *= 16777619UL;
+    hash ^= *c;
+  }
+  hash *= 16777619UL;
+  return hash ^ static_cast<uint32_t>(line);
+}
+uint16_t APIServer::get_log_call_site_id(const char *tag, int line, const char *format) {
+  const uint32_t hash = log_call_site_hash(tag, line, format);
+  auto range = this->log_call_site_ids_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const LogCallSite &site = this->log_call_sites_[it->second - 1];
+    if (site.line == line && site.tag == tag && site.format == format)
+      return it->second;
+  }
+  if (this->log_call_sites_.size() >= MAX_LOG_CALL_SITES)
+    return 0;
+  this->log_call_sites_.push_back(LogCallSite{tag, format, line});
+  const uint16_t id = this->log_call_sites_.size();
+  this->log_call_site_ids_.emplace(hash, id);
+  return id;
+}
+#endif
 #ifdef USE_HOMEASSISTANT_TIME
 void APIServer::request_time() {
   for (auto &client : this->clients_) {
@@ -15,6 +15,10 @@
 #include "user_services.h"
 
 #include <vector>
+#ifdef USE_API_BINARY_LOGS
+#include <string>
+#include <unordered_map>
+#endif
 
 namespace esphome {
 namespace api {
@@ -33,6 +37,19 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+#ifdef USE_API_BATCHING
+  /// Messages sent within this many milliseconds of the first one are coalesced into a single write.
+  void set_batch_delay(uint16_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint16_t get_batch_delay() const { return this->batch_delay_; }
+  void record_batch(uint16_t messages) {
+    this->batch_messages_ += messages;
+    this->batch_writes_++;
+  }
+  /// Total number of messages sent as part of a batch, across all connections.
+  uint32_t get_batch_messages() const { return this->batch_messages_; }
+  /// Total number of batched socket writes, across all connections.
+  uint32_t get_batch_writes() const { return this->batch_writes_; }
+#endif
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -109,6 +126,20 @@ class APIServer : public Component, public Controller {
 
   bool is_connected() const;
 
+#ifdef USE_API_BINARY_LOGS
+  struct LogCallSite {
+    std::string tag;
+    std::string format;
+    int line;
+  };
+  /** Id of a log call site for binary log subscribers (starting at 1), assigned on first use. 0 if out of ids.
+   *
+   * Call sites are matched by the content of \p tag and \p format, not their address, because some log calls pass
+   * format strings built at runtime.
+   */
+  uint16_t get_log_call_site_id(const char *tag, int line, const char *format);
+#endif
+
   struct HomeAssistantStateSubscription {
     std::string entity_id;
     optional<std::string> attribute;
@@ -133,6 +164,11 @@ class APIServer : public Component, public Controller {
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
   uint32_t last_connected_{0};
+#ifdef USE_API_BATCHING
+  uint32_t batch_messages_{0};
+  uint32_t batch_writes_{0};
+  uint16_t batch_delay_{0};
+#endif
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
@@ -140,6 +176,16 @@ class APIServer : public Component, public Controller {
   Trigger<std::string, std::string> *client_connected_trigger_ = new Trigger<std::string, std::string>();
   Trigger<std::string, std::string> *client_disconnected_trigger_ = new Trigger<std::string, std::string>();
 
+#ifdef USE_API_BINARY_LOGS
+  /// Call sites beyond this many are sent as text, this bounds the memory used for their copies
+  static const uint16_t MAX_LOG_CALL_SITES = 1024;
+  std::vector<LogCallSite> log_call_sites_;
+  /// Ids of the call sites in log_call_sites_, by a hash of their tag, format and line
+  std::unordered_multimap<uint32_t, uint16_t> log_call_site_ids_;
+  /// Arguments of the current log message, encoded once for all binary subscribers
+  std::vector<uint8_t> log_args_buffer_;
+#endif
+
 #ifdef USE_API_NOISE
   std::shared_ptr<APINoiseContext> noise_ctx_ = std::make_shared<APINoiseContext>();
 #endif  // USE_API_NOISE
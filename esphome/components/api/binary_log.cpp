@@ -0,0 +1,161 @@
+#include "binary_log.h"
+#ifdef USE_API_BINARY_LOGS
+#include <cstring>
+#include "proto.h"
+
+namespace esphome {
+namespace api {
+
+enum class LengthModifier { NONE, HH, H, L, LL, J, Z, T, BIG_L };
+
+static void encode_signed(std::vector<uint8_t> &out, int64_t value) {
+  ProtoVarInt(ProtoSize::zigzag(value)).encode(out);
+}
+static void encode_unsigned(std::vector<uint8_t> &out, uint64_t value) { ProtoVarInt(value).encode(out); }
+
+void encode_log_args(const char *format, va_list args, std::vector<uint8_t> &out) {
+  const char *p = format;
+  while (*p != '\0') {
+    if (*p++ != '%')
+      continue;
+    // flags
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      p++;
+    // width
+    if (*p == '*') {
+      encode_signed(out, va_arg(args, int));
+      p++;
+    } else {
+      while (*p >= '0' && *p <= '9')
+        p++;
+    }
+    // precision
+    if (*p == '.') {
+      p++;
+      if (*p == '*') {
+        encode_signed(out, va_arg(args, int));
+        p++;
+      } else {
+        while (*p >= '0' && *p <= '9')
+          p++;
+      }
+    }
+    // length modifier
+    LengthModifier length = LengthModifier::NONE;
+    if (*p == 'h') {
+      length = p[1] == 'h' ? LengthModifier::HH : LengthModifier::H;
+      p += length == LengthModifier::HH ? 2 : 1;
+    } else if (*p == 'l') {
+      length = p[1] == 'l' ? LengthModifier::LL : LengthModifier::L;
+      p += length == LengthModifier::LL ? 2 : 1;
+    } else if (*p == 'j') {
+      length = LengthModifier::J;
+      p++;
+    } else if (*p == 'z') {
+      length = LengthModifier::Z;
+      p++;
+    } else if (*p == 't') {
+      length = LengthModifier::T;
+      p++;
+    } else if (*p == 'L') {
+      length = LengthModifier::BIG_L;
+      p++;
+    }
+
+    const char conversion = *p;
+    if (conversion == '\0')
+      return;
+    p++;
+    switch (conversion) {
+      case 'd':
+      case 'i':
+        switch (length) {
+          case LengthModifier::L:
+            encode_signed(out, va_arg(args, long));
+            break;
+          case LengthModifier::LL:
+          case LengthModifier::J:
+            encode_signed(out, va_arg(args, long long));
+            break;
+          case LengthModifier::Z:
+          case LengthModifier::T:
+            encode_signed(out, va_arg(args, ptrdiff_t));
+            break;
+          default:
+            // char and short are promoted to int
+            encode_signed(out, va_arg(args, int));
+            break;
+        }
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        switch (length) {
+          case LengthModifier::L:
+            encode_unsigned(out, va_arg(args, unsigned long));
+            break;
+          case LengthModifier::LL:
+          case LengthModifier::J:
+            encode_unsigned(out, va_arg(args, unsigned long long));
+            break;
+          case LengthModifier::Z:
+          case LengthModifier::T:
+            encode_unsigned(out, va_arg(args, size_t));
+            break;
+          case LengthModifier::HH:
+            encode_unsigned(out, static_cast<uint8_t>(va_arg(args, unsigned int)));
+            break;
+          case LengthModifier::H:
+            encode_unsigned(out, static_cast<uint16_t>(va_arg(args, unsigned int)));
+            break;
+          default:
+            encode_unsigned(out, va_arg(args, unsigned int));
+            break;
+        }
+        break;
+      case 'c':
+        encode_unsigned(out, static_cast<uint8_t>(va_arg(args, int)));
+        break;
+      case 'p':
+        encode_unsigned(out, reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        break;
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A': {
+        double value = length == LengthModifier::BIG_L ? static_cast<double>(va_arg(args, long double))
+                                                       : va_arg(args, double);
+        uint64_t raw;
+        memcpy(&raw, &value, sizeof(raw));
+        for (int i = 0; i < 8; i++)
+          out.push_back(static_cast<uint8_t>(raw >> (i * 8)));
+        break;
+      }
+      case 's': {
+        const char *str = va_arg(args, const char *);
+        if (str == nullptr)
+          str = "(null)";
+        const size_t len = strlen(str);
+        encode_unsigned(out, len);
+        out.insert(out.end(), str, str + len);
+        break;
+      }
+      case 'n':
+        // never write through %n, just consume the pointer
+        (void) va_arg(args, void *);
+        break;
+      default:
+        // %% and unknown conversions take no argument
+        break;
+    }
+  }
+}
+
+}  // namespace api
+}  // namespace esphome
+#endif
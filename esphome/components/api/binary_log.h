@@ -0,0 +1,23 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_API_BINARY_LOGS
+#include <cstdarg>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+/** Encode the arguments of a printf-style log call without rendering it.
+ *
+ * The format string is walked like vsnprintf would, and every argument it consumes is appended to \p out:
+ * integers (and `*` widths/precisions) as varints, signed ones zigzag encoded, floating point values as
+ * 8 byte little endian doubles and strings as a varint length followed by the bytes. The client renders the
+ * message from the same format string, see esphome/components/api/binary_log.py.
+ */
+void encode_log_args(const char *format, va_list args, std::vector<uint8_t> &out);
+
+}  // namespace api
+}  // namespace esphome
+#endif
@@ -0,0 +1,151 @@
+"""Render binary log messages sent by devices with `binary_logs` enabled.
+
+Instead of rendered text, the device sends a call site id with the raw arguments of
+the log call. The format string, tag and line of a call site are sent along with its
+first message on each connection. See encode_log_args() in binary_log.cpp for the
+argument encoding.
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+import re
+import struct
+
+# Same as LOG_LEVEL_COLORS/LOG_LEVEL_LETTERS in components/logger/logger.cpp
+LOG_LEVEL_COLORS = (
+    "",
+    "\033[1;31m",
+    "\033[0;33m",
+    "\033[0;32m",
+    "\033[0;35m",
+    "\033[0;36m",
+    "\033[0;37m",
+    "\033[0;38m",
+)
+LOG_LEVEL_LETTERS = ("", "E", "W", "I", "C", "D", "V", "VV")
+LOG_RESET_COLOR = "\033[0m"
+
+FORMAT_SPEC_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conversion>[diouxXeEfFgGaAcspn%])"
+)
+SIGNED_CONVERSIONS = "di"
+UNSIGNED_CONVERSIONS = "ouxX"
+FLOAT_CONVERSIONS = "eEfFgGaA"
+
+
+@dataclass
+class LogCallSite:
+    tag: str
+    format: str
+    line: int
+
+
+class _ArgReader:
+    def __init__(self, data: bytes) -> None:
+        self._data = data
+        self._pos = 0
+
+    def varint(self) -> int:
+        result = 0
+        shift = 0
+        while True:
+            if self._pos >= len(self._data):
+                raise ValueError("Truncated log arguments")
+            byte = self._data[self._pos]
+            self._pos += 1
+            result |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return result
+            shift += 7
+
+    def signed(self) -> int:
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def double(self) -> float:
+        (value,) = struct.unpack_from("<d", self._data, self._pos)
+        self._pos += 8
+        return value
+
+    def string(self) -> str:
+        length = self.varint()
+        value = self._data[self._pos : self._pos + length]
+        self._pos += length
+        return value.decode("utf8", "backslashreplace")
+
+
+def render_message(fmt: str, args: bytes) -> str:
+    """Render a printf-style format string with arguments encoded by the device."""
+    reader = _ArgReader(args)
+    out = []
+    last = 0
+    for match in FORMAT_SPEC_RE.finditer(fmt):
+        out.append(fmt[last : match.start()])
+        last = match.end()
+        conversion = match["conversion"]
+        if conversion == "%":
+            out.append("%")
+            continue
+        width = match["width"] or ""
+        if width == "*":
+            width = str(reader.signed())
+        precision = match["precision"]
+        if precision == "*":
+            precision = str(reader.signed())
+        spec = "%" + match["flags"] + width
+        if precision is not None:
+            spec += "." + precision
+
+        if conversion in SIGNED_CONVERSIONS:
+            out.append((spec + "d") % reader.signed())
+        elif conversion in UNSIGNED_CONVERSIONS:
+            out.append((spec + conversion.replace("u", "d")) % reader.varint())
+        elif conversion in FLOAT_CONVERSIONS:
+            value = reader.double()
+            if conversion in "aA":
+                out.append(float.hex(value))
+            else:
+                out.append((spec + conversion) % value)
+        elif conversion == "c":
+            out.append((spec + "c") % reader.varint())
+        elif conversion == "p":
+            out.append(hex(reader.varint()))
+        elif conversion == "s":
+            out.append((spec + "s") % reader.string())
+        # %n consumes an argument on the device but nothing is sent for it
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+class BinaryLogRenderer:
+    """Keeps the call sites received on one connection and renders messages."""
+
+    def __init__(self) -> None:
+        self._call_sites: dict[int, LogCallSite] = {}
+
+    def render(
+        self,
+        level: int,
+        format_id: int,
+        args: bytes,
+        fmt: str = "",
+        tag: str = "",
+        line: int = 0,
+    ) -> str:
+        if fmt:
+            self._call_sites[format_id] = LogCallSite(tag, fmt, line)
+        call_site = self._call_sites.get(format_id)
+        if call_site is None:
+            return f"[?][unknown log call site {format_id}]"
+        level = max(0, min(level, len(LOG_LEVEL_LETTERS) - 1))
+        color = LOG_LEVEL_COLORS[level]
+        try:
+            text = render_message(call_site.format, args)
+        except (ValueError, TypeError, struct.error) as err:
+            text = f"{call_site.format!r} (could not render arguments: {err})"
+        return (
+            f"{color}[{LOG_LEVEL_LETTERS[level]}][{call_site.tag}:{call_site.line:03}]: "
+            f"{text}{LOG_RESET_COLOR}"
+        )
@@ -13,6 +13,7 @@ from esphome.const import CONF_KEY, CONF_PASSWORD, CONF_PORT, __version__
 from esphome.core import CORE
 
 from . import CONF_ENCRYPTION
+from .binary_log import BinaryLogRenderer
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -35,12 +36,18 @@ async def async_run_logs(config: dict[str, Any], address: str) -> None:
         noise_psk=noise_psk,
     )
     dashboard = CORE.dashboard
+    binary_log_renderer = BinaryLogRenderer()
 
     def on_log(msg: SubscribeLogsResponse) -> None:
         """Handle a new log message."""
         time_ = datetime.now()
-        message: bytes = msg.message
-        text = message.decode("utf8", "backslashreplace")
+        if format_id := getattr(msg, "format_id", 0):
+            text = binary_log_renderer.render(
+                msg.level, format_id, msg.args, msg.format, msg.tag, msg.line
+            )
+        else:
+            message: bytes = msg.message
+            text = message.decode("utf8", "backslashreplace")
         if dashboard:
             text = text.replace("\033", "\\033")
         print(f"[{time_.hour:02}:{time_.minute:02}:{time_.second:02}]{text}")
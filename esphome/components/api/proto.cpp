@@ -7,6 +7,13 @@ namespace api {
 
 static const char *const TAG = "api.proto";
 
+void ProtoVarInt::encode_multi_byte_(std::vector<uint8_t> &out) {
+  const uint32_t len = ProtoSize::varint(this->value_);
+  const size_t pos = out.size();
+  out.resize(pos + len);
+  this->encode_to_buffer_unchecked(out.data() + pos, len);
+}
+
 void ProtoMessage::decode(const uint8_t *buffer, size_t length) {
   uint32_t i = 0;
   bool error = false;
@@ -71,24 +71,27 @@ class ProtoVarInt {
       return static_cast<int64_t>(this->value_ >> 1);
     }
   }
-  void encode(std::vector<uint8_t> &out) {
+  /// Write the varint to \p buffer, which must have room for at least \p len bytes (see ProtoSize::varint()).
+  void encode_to_buffer_unchecked(uint8_t *buffer, size_t len) {
     uint64_t val = this->value_;
-    if (val <= 0x7F) {
-      out.push_back(val);
-      return;
-    }
-    while (val) {
-      uint8_t temp = val & 0x7F;
+    for (size_t i = 0; i < len - 1; i++) {
+      buffer[i] = (val & 0x7F) | 0x80;
       val >>= 7;
-      if (val) {
-        out.push_back(temp | 0x80);
-      } else {
-        out.push_back(temp);
-      }
     }
+    buffer[len - 1] = val & 0x7F;
+  }
+  void encode(std::vector<uint8_t> &out) {
+    // Tags, lengths and most values fit in one byte
+    if (this->value_ < 0x80) {
+      out.push_back(static_cast<uint8_t>(this->value_));
+      return;
+    }
+    this->encode_multi_byte_(out);
   }
 
  protected:
+  void encode_multi_byte_(std::vector<uint8_t> &out);
+
   uint64_t value_;
 };
 
@@ -143,6 +146,123 @@ class Proto64Bit {
   const uint64_t value_;
 };
 
+/** Encoded sizes of protobuf fields, mirroring the encode_* methods of ProtoWriteBuffer.
+ *
+ * Generated messages use these in calculate_size() so a message can be written in one pass into a buffer
+ * of the right size, and nested messages can be prefixed with their length before they are encoded.
+ */
+class ProtoSize {
+ public:
+  static inline uint32_t varint(uint32_t value) {
+    if (value < (1UL << 7))
+      return 1;
+    if (value < (1UL << 14))
+      return 2;
+    if (value < (1UL << 21))
+      return 3;
+    if (value < (1UL << 28))
+      return 4;
+    return 5;
+  }
+  static inline uint32_t varint(uint64_t value) {
+    if (value <= UINT32_MAX)
+      return varint(static_cast<uint32_t>(value));
+    uint32_t size = 5;
+    value >>= 35;
+    while (value != 0) {
+      value >>= 7;
+      size++;
+    }
+    return size;
+  }
+  static inline uint32_t zigzag(int32_t value) { return value < 0 ? ~(value << 1) : (value << 1); }
+  static inline uint64_t zigzag(int64_t value) { return value < 0 ? ~(value << 1) : (value << 1); }
+
+  static inline void add_uint32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value,
+                                      bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static inline void add_int32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      total_size += field_id_size + 10;
+      return;
+    }
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static inline void add_sint32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force = false) {
+    add_uint32_field(total_size, field_id_size, zigzag(value), force);
+  }
+  static inline void add_uint64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value,
+                                      bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static inline void add_int64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id_size, static_cast<uint64_t>(value), force);
+  }
+  static inline void add_sint64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id_size, zigzag(value), force);
+  }
+  static inline void add_bool_field(uint32_t &total_size, uint32_t field_id_size, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field_id_size + 1;
+  }
+  static inline void add_fixed32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value,
+                                       bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 4;
+  }
+  static inline void add_float_field(uint32_t &total_size, uint32_t field_id_size, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field_id_size + 4;
+  }
+  static inline void add_fixed64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value,
+                                       bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 8;
+  }
+  static inline void add_double_field(uint32_t &total_size, uint32_t field_id_size, double value, bool force = false) {
+    if (value == 0.0 && !force)
+      return;
+    total_size += field_id_size + 8;
+  }
+  static inline void add_sfixed32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value,
+                                        bool force = false) {
+    add_fixed32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static inline void add_sfixed64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value,
+                                        bool force = false) {
+    add_fixed64_field(total_size, field_id_size, static_cast<uint64_t>(value), force);
+  }
+  template<typename T>
+  static inline void add_enum_field(uint32_t &total_size, uint32_t field_id_size, T value, bool force = false) {
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static inline void add_string_field(uint32_t &total_size, uint32_t field_id_size, const std::string &value,
+                                      bool force = false) {
+    if (value.empty() && !force)
+      return;
+    const uint32_t len = value.size();
+    total_size += field_id_size + varint(len) + len;
+  }
+  /// Nested messages are always encoded, even when empty.
+  template<class C>
+  static inline void add_message_field(uint32_t &total_size, uint32_t field_id_size, const C &value,
+                                       bool force = false) {
+    uint32_t nested_size = 0;
+    value.calculate_size(nested_size);
+    total_size += field_id_size + varint(nested_size) + nested_size;
+  }
+};
+
 class ProtoWriteBuffer {
  public:
   ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
@@ -163,7 +283,9 @@ class ProtoWriteBuffer {
     this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    if (value.empty() && !force)
+      return;
+    this->encode_string(field_id, value.data(), value.size(), true);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -200,7 +322,7 @@ class ProtoWriteBuffer {
     if (value == 0 && !force)
       return;
 
-    this->encode_field_raw(field_id, 5);
+    this->encode_field_raw(field_id, 1);
     this->write((value >> 0) & 0xFF);
     this->write((value >> 8) & 0xFF);
     this->write((value >> 16) & 0xFF);
@@ -222,7 +344,7 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, true);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -255,15 +377,11 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // Write the length first so the nested message can be encoded in place
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -275,6 +393,8 @@ class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the encoded size of this message to \p total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -298,12 +418,15 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /// Create a buffer for a new message, with room for \p reserve_size bytes of payload.
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    // The write buffer is reused and keeps its capacity, so sizing every message up front would cost more than it
+    // saves. Only nested messages are sized, to write their length before them.
+    auto buffer = this->create_buffer(0);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -16,6 +16,7 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
   void set_address(uint64_t address) {
     this->match_by_ = MATCH_BY_MAC_ADDRESS;
     this->address_ = address;
+    this->add_address_filter(address);
   }
   void set_irk(uint8_t *irk) {
     this->match_by_ = MATCH_BY_IRK;
@@ -68,11 +69,9 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
         }
         break;
       case MATCH_BY_SERVICE_UUID:
-        for (auto uuid : device.get_service_uuids()) {
-          if (this->uuid_ == uuid) {
-            this->set_found_(true);
-            return true;
-          }
+        if (device.has_service_uuid(this->uuid_)) {
+          this->set_found_(true);
+          return true;
         }
         break;
       case MATCH_BY_IBEACON_UUID:
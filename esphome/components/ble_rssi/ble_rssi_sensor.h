@@ -14,6 +14,7 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
   void set_address(uint64_t address) {
     this->match_by_ = MATCH_BY_MAC_ADDRESS;
     this->address_ = address;
+    this->add_address_filter(address);
   }
   void set_irk(uint8_t *irk) {
     this->match_by_ = MATCH_BY_IRK;
@@ -65,12 +66,10 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
         }
         break;
       case MATCH_BY_SERVICE_UUID:
-        for (auto uuid : device.get_service_uuids()) {
-          if (this->uuid_ == uuid) {
-            this->publish_state(device.get_rssi());
-            this->found_ = true;
-            return true;
-          }
+        if (device.has_service_uuid(this->uuid_)) {
+          this->publish_state(device.get_rssi());
+          this->found_ = true;
+          return true;
         }
         break;
       case MATCH_BY_IBEACON_UUID:
@@ -39,50 +39,103 @@ bool BluetoothProxy::parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_p
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr || !this->raw_advertisements_)
     return false;
 
-  api::BluetoothLERawAdvertisementsResponse resp;
   for (size_t i = 0; i < count; i++) {
     auto &result = advertisements[i];
-    api::BluetoothLERawAdvertisement adv;
-    adv.address = esp32_ble::ble_addr_to_uint64(result.bda);
-    adv.rssi = result.rssi;
-    adv.address_type = result.ble_addr_type;
-
-    uint8_t length = result.adv_data_len + result.scan_rsp_len;
-    adv.data.reserve(length);
-    for (uint16_t i = 0; i < length; i++) {
-      adv.data.push_back(result.ble_adv[i]);
+    if (!this->add_raw_advertisement_(result)) {
+      ESP_LOGVV(TAG, "Skipping duplicate raw packet from %02X:%02X:%02X:%02X:%02X:%02X", result.bda[0], result.bda[1],
+                result.bda[2], result.bda[3], result.bda[4], result.bda[5]);
+      continue;
     }
-
-    resp.advertisements.push_back(std::move(adv));
-
     ESP_LOGV(TAG, "Proxying raw packet from %02X:%02X:%02X:%02X:%02X:%02X, length %d. RSSI: %d dB", result.bda[0],
-             result.bda[1], result.bda[2], result.bda[3], result.bda[4], result.bda[5], length, result.rssi);
+             result.bda[1], result.bda[2], result.bda[3], result.bda[4], result.bda[5],
+             result.adv_data_len + result.scan_rsp_len, result.rssi);
+    if (this->raw_advertisements_buffer_.size() >= RAW_ADVERTISEMENTS_MAX_BATCH_BYTES)
+      this->flush_raw_advertisements_();
+  }
+  return true;
+}
+
+bool BluetoothProxy::add_raw_advertisement_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result) {
+  const uint64_t address = esp32_ble::ble_addr_to_uint64(result.bda);
+  const uint8_t data_len = result.adv_data_len + result.scan_rsp_len;
+  // The same advertisement is usually received many times per second, only the first one in a batch is sent
+  for (auto &pending : this->raw_advertisements_pending_) {
+    if (pending.address == address && pending.data_len == data_len &&
+        memcmp(this->raw_advertisements_buffer_.data() + pending.data_offset, result.ble_adv, data_len) == 0)
+      return false;
   }
-  ESP_LOGV(TAG, "Proxying %d packets", count);
-  this->api_connection_->send_bluetooth_le_raw_advertisements_response(resp);
+
+  if (this->raw_advertisements_pending_.empty())
+    this->raw_advertisements_batch_start_ = millis();
+
+  uint32_t size = 0;
+  api::ProtoSize::add_uint64_field(size, 1, address);
+  api::ProtoSize::add_sint32_field(size, 1, result.rssi);
+  api::ProtoSize::add_uint32_field(size, 1, result.ble_addr_type);
+  if (data_len != 0)
+    size += 1 + api::ProtoSize::varint(static_cast<uint32_t>(data_len)) + data_len;
+
+  // Encode as BluetoothLERawAdvertisementsResponse.advertisements directly, without a temporary message
+  api::ProtoWriteBuffer buffer(&this->raw_advertisements_buffer_);
+  // repeated BluetoothLERawAdvertisement advertisements = 1;
+  buffer.encode_field_raw(1, 2);
+  buffer.encode_varint_raw(size);
+  // uint64 address = 1;
+  buffer.encode_uint64(1, address);
+  // sint32 rssi = 2;
+  buffer.encode_sint32(2, result.rssi);
+  // uint32 address_type = 3;
+  buffer.encode_uint32(3, result.ble_addr_type);
+  // bytes data = 4;
+  buffer.encode_bytes(4, result.ble_adv, data_len);
+
+  const uint16_t data_offset = this->raw_advertisements_buffer_.size() - data_len;
+  this->raw_advertisements_pending_.push_back({address, data_offset, data_len});
   return true;
 }
+
+void BluetoothProxy::flush_raw_advertisements_() {
+  if (this->raw_advertisements_pending_.empty())
+    return;
+  ESP_LOGV(TAG, "Proxying %zu packets", this->raw_advertisements_pending_.size());
+  if (this->api_connection_ != nullptr) {
+    // BluetoothLERawAdvertisementsResponse - 93
+    this->api_connection_->send_buffer(api::ProtoWriteBuffer(&this->raw_advertisements_buffer_), 93);
+  }
+  // a batch that could not be sent is dropped, the devices will advertise again
+  this->raw_advertisements_buffer_.clear();
+  this->raw_advertisements_pending_.clear();
+}
+
 void BluetoothProxy::send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device) {
   api::BluetoothLEAdvertisementResponse resp;
   resp.address = device.address_uint64();
   resp.address_type = device.get_address_type();
-  if (!device.get_name().empty())
-    resp.name = device.get_name();
   resp.rssi = device.get_rssi();
-  for (auto uuid : device.get_service_uuids()) {
-    resp.service_uuids.push_back(uuid.to_string());
-  }
-  for (auto &data : device.get_service_datas()) {
-    api::BluetoothServiceData service_data;
-    service_data.uuid = data.uuid.to_string();
-    service_data.data.assign(data.data.begin(), data.data.end());
-    resp.service_data.push_back(std::move(service_data));
-  }
-  for (auto &data : device.get_manufacturer_datas()) {
-    api::BluetoothServiceData manufacturer_data;
-    manufacturer_data.uuid = data.uuid.to_string();
-    manufacturer_data.data.assign(data.data.begin(), data.data.end());
-    resp.manufacturer_data.push_back(std::move(manufacturer_data));
+  // copy straight from the advertisement data instead of having the device parse it
+  esp32_ble_tracker::ServiceDataView data;
+  for (auto record : device.get_adv_records()) {
+    if (record.type == ESP_BLE_AD_TYPE_NAME_SHORT || record.type == ESP_BLE_AD_TYPE_NAME_CMPL) {
+      // keep the longest name, the same as ESPBTDevice::get_name()
+      if (record.length > resp.name.length())
+        resp.name.assign(reinterpret_cast<const char *>(record.data), record.length);
+      continue;
+    }
+    const uint8_t uuid_count = record.get_service_uuid_count();
+    for (uint8_t i = 0; i < uuid_count; i++) {
+      resp.service_uuids.push_back(record.get_service_uuid(i).to_string());
+    }
+    if (record.get_service_data(data)) {
+      api::BluetoothServiceData service_data;
+      service_data.uuid = data.uuid.to_string();
+      service_data.data.assign(data.data, data.data + data.length);
+      resp.service_data.push_back(std::move(service_data));
+    } else if (record.get_manufacturer_data(data)) {
+      api::BluetoothServiceData manufacturer_data;
+      manufacturer_data.uuid = data.uuid.to_string();
+      manufacturer_data.data.assign(data.data, data.data + data.length);
+      resp.manufacturer_data.push_back(std::move(manufacturer_data));
+    }
   }
   this->api_connection_->send_bluetooth_le_advertisement(resp);
 }
@@ -117,6 +170,10 @@ void BluetoothProxy::loop() {
     }
     return;
   }
+  if (!this->raw_advertisements_pending_.empty() &&
+      millis() - this->raw_advertisements_batch_start_ >= RAW_ADVERTISEMENTS_MAX_LATENCY_MS) {
+    this->flush_raw_advertisements_();
+  }
   for (auto *connection : this->connections_) {
     if (connection->send_service_ == connection->service_count_) {
       connection->send_service_ = DONE_SENDING_SERVICES;
@@ -456,6 +513,8 @@ void BluetoothProxy::unsubscribe_api_connection(api::APIConnection *api_connecti
   }
   this->api_connection_ = nullptr;
   this->raw_advertisements_ = false;
+  this->raw_advertisements_buffer_.clear();
+  this->raw_advertisements_pending_.clear();
   this->parent_->recalculate_advertisement_parser_types();
 }
 
@@ -31,6 +31,11 @@ using namespace esp32_ble_client;
 static const uint32_t LEGACY_ACTIVE_CONNECTIONS_VERSION = 5;
 static const uint32_t LEGACY_PASSIVE_ONLY_VERSION = 1;
 
+/// Send the pending raw advertisements once their encoded size reaches this many bytes.
+static const size_t RAW_ADVERTISEMENTS_MAX_BATCH_BYTES = 1280;
+/// Send the pending raw advertisements at the latest this long after the first one was received.
+static const uint32_t RAW_ADVERTISEMENTS_MAX_LATENCY_MS = 100;
+
 enum BluetoothProxyFeature : uint32_t {
   FEATURE_PASSIVE_SCAN = 1 << 0,
   FEATURE_ACTIVE_CONNECTIONS = 1 << 1,
@@ -116,6 +121,9 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
 
  protected:
   void send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device);
+  /// Encode a raw advertisement into the pending batch, returns false if it duplicates a pending one.
+  bool add_raw_advertisement_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result);
+  void flush_raw_advertisements_();
 
   BluetoothConnection *get_connection_(uint64_t address, bool reserve);
 
@@ -124,6 +132,17 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   std::vector<BluetoothConnection *> connections_{};
   api::APIConnection *api_connection_{nullptr};
   bool raw_advertisements_{false};
+
+  struct PendingRawAdvertisement {
+    uint64_t address;
+    /// Offset of the advertisement data in raw_advertisements_buffer_.
+    uint16_t data_offset;
+    uint8_t data_len;
+  };
+  /// Already encoded BluetoothLERawAdvertisementsResponse, sent as is.
+  std::vector<uint8_t> raw_advertisements_buffer_;
+  std::vector<PendingRawAdvertisement> raw_advertisements_pending_;
+  uint32_t raw_advertisements_batch_start_{0};
 };
 
 extern BluetoothProxy *global_bluetooth_proxy;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -13,6 +14,11 @@ namespace debug {
 
 static const char *const TAG = "debug";
 
+#ifdef USE_COMPONENT_PROFILER
+/// Number of components listed in the periodic profiler log.
+static const uint8_t PROFILE_LOG_TOP_COMPONENTS = 5;
+#endif
+
 void DebugComponent::dump_config() {
 #ifndef ESPHOME_LOG_HAS_DEBUG
   return;  // Can't log below if debug logging is disabled
@@ -29,6 +35,10 @@ void DebugComponent::dump_config() {
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
 #endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
 #endif  // USE_SENSOR
+#ifdef USE_COMPONENT_PROFILER
+  ESP_LOGCONFIG(TAG, "  Component profiler: %u bytes of RAM per component, %u components",
+                (unsigned) sizeof(ComponentProfile), (unsigned) App.get_components().size());
+#endif  // USE_COMPONENT_PROFILER
 
   std::string device_info;
   device_info.reserve(256);
@@ -88,9 +98,73 @@ void DebugComponent::update() {
   }
 
 #endif  // USE_SENSOR
+#ifdef USE_COMPONENT_PROFILER
+  this->update_profile_();
+#endif
+  const uint32_t skipped = App.get_total_loop_skipped_components();
+  if (skipped != this->last_loop_skipped_components_) {
+    ESP_LOGD(TAG, "Skipped %" PRIu32 " loop() calls of components waiting for a wake",
+             skipped - this->last_loop_skipped_components_);
+    this->last_loop_skipped_components_ = skipped;
+  }
   update_platform_();
 }
 
+#ifdef USE_COMPONENT_PROFILER
+void DebugComponent::update_profile_() {
+  Component *top[PROFILE_LOG_TOP_COMPONENTS] = {};
+  uint64_t component_loop_us = 0;
+  uint64_t scheduler_us = 0;
+  for (auto *component : App.get_components()) {
+    auto &profile = component->get_profile();
+    component_loop_us += profile.loop_total_us;
+    scheduler_us += profile.scheduler_total_us;
+    if (profile.loop_count == 0)
+      continue;
+    // Keep the components with the highest total loop() time, sorted descending
+    for (uint8_t i = 0; i < PROFILE_LOG_TOP_COMPONENTS; i++) {
+      if (top[i] == nullptr || profile.loop_total_us > top[i]->get_profile().loop_total_us) {
+        for (uint8_t j = PROFILE_LOG_TOP_COMPONENTS - 1; j > i; j--)
+          top[j] = top[j - 1];
+        top[i] = component;
+        break;
+      }
+    }
+  }
+
+  ESP_LOGD(TAG, "Components with the most time spent in loop():");
+  for (auto *component : top) {
+    if (component == nullptr)
+      break;
+    auto &profile = component->get_profile();
+    ESP_LOGD(TAG, "  %s: %" PRIu32 " calls, total=%" PRIu32 "ms avg=%" PRIu32 "us p99<=%" PRIu32 "us max=%" PRIu32 "us",
+             component->get_component_source(), profile.loop_count, (uint32_t) (profile.loop_total_us / 1000),
+             (uint32_t) (profile.loop_total_us / profile.loop_count), profile.loop_percentile_us(99),
+             profile.loop_max_us);
+  }
+
+  // Totals only grow unless they were reset through the API
+  const uint64_t component_loop_delta =
+      component_loop_us >= this->last_component_loop_us_ ? component_loop_us - this->last_component_loop_us_
+                                                         : component_loop_us;
+  const uint64_t scheduler_delta =
+      scheduler_us >= this->last_scheduler_us_ ? scheduler_us - this->last_scheduler_us_ : scheduler_us;
+  this->last_component_loop_us_ = component_loop_us;
+  this->last_scheduler_us_ = scheduler_us;
+
+#ifdef USE_SENSOR
+  if (this->component_loop_time_sensor_ != nullptr)
+    this->component_loop_time_sensor_->publish_state(component_loop_delta / 1000.0f);
+  if (this->scheduler_time_sensor_ != nullptr)
+    this->scheduler_time_sensor_->publish_state(scheduler_delta / 1000.0f);
+#endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+  if (this->slowest_component_ != nullptr && top[0] != nullptr)
+    this->slowest_component_->publish_state(top[0]->get_component_source());
+#endif  // USE_TEXT_SENSOR
+}
+#endif  // USE_COMPONENT_PROFILER
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
@@ -25,6 +25,11 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   void set_device_info_sensor(text_sensor::TextSensor *device_info) { device_info_ = device_info; }
   void set_reset_reason_sensor(text_sensor::TextSensor *reset_reason) { reset_reason_ = reset_reason; }
+#ifdef USE_COMPONENT_PROFILER
+  void set_slowest_component_sensor(text_sensor::TextSensor *slowest_component) {
+    slowest_component_ = slowest_component;
+  }
+#endif  // USE_COMPONENT_PROFILER
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   void set_free_sensor(sensor::Sensor *free_sensor) { free_sensor_ = free_sensor; }
@@ -33,12 +38,21 @@ class DebugComponent : public PollingComponent {
   void set_fragmentation_sensor(sensor::Sensor *fragmentation_sensor) { fragmentation_sensor_ = fragmentation_sensor; }
 #endif
   void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { loop_time_sensor_ = loop_time_sensor; }
+#ifdef USE_COMPONENT_PROFILER
+  void set_component_loop_time_sensor(sensor::Sensor *component_loop_time_sensor) {
+    component_loop_time_sensor_ = component_loop_time_sensor;
+  }
+  void set_scheduler_time_sensor(sensor::Sensor *scheduler_time_sensor) {
+    scheduler_time_sensor_ = scheduler_time_sensor;
+  }
+#endif  // USE_COMPONENT_PROFILER
 #ifdef USE_ESP32
   void set_psram_sensor(sensor::Sensor *psram_sensor) { this->psram_sensor_ = psram_sensor; }
 #endif  // USE_ESP32
 #endif  // USE_SENSOR
  protected:
   uint32_t free_heap_{};
+  uint32_t last_loop_skipped_components_{0};
 
 #ifdef USE_SENSOR
   uint32_t last_loop_timetag_{0};
@@ -50,6 +64,10 @@ class DebugComponent : public PollingComponent {
   sensor::Sensor *fragmentation_sensor_{nullptr};
 #endif
   sensor::Sensor *loop_time_sensor_{nullptr};
+#ifdef USE_COMPONENT_PROFILER
+  sensor::Sensor *component_loop_time_sensor_{nullptr};
+  sensor::Sensor *scheduler_time_sensor_{nullptr};
+#endif  // USE_COMPONENT_PROFILER
 #ifdef USE_ESP32
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
@@ -72,8 +90,19 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *device_info_{nullptr};
   text_sensor::TextSensor *reset_reason_{nullptr};
+#ifdef USE_COMPONENT_PROFILER
+  text_sensor::TextSensor *slowest_component_{nullptr};
+#endif  // USE_COMPONENT_PROFILER
 #endif  // USE_TEXT_SENSOR
 
+#ifdef USE_COMPONENT_PROFILER
+  /// Publish the profiler sensors and log the components spending the most time in loop().
+  void update_profile_();
+
+  uint64_t last_component_loop_us_{0};
+  uint64_t last_scheduler_us_{0};
+#endif  // USE_COMPONENT_PROFILER
+
   std::string get_reset_reason_();
   uint32_t get_free_heap_();
   void get_device_info_(std::string &device_info);
@@ -18,6 +18,8 @@ from . import CONF_DEBUG_ID, DebugComponent
 DEPENDENCIES = ["debug"]
 
 CONF_PSRAM = "psram"
+CONF_COMPONENT_LOOP_TIME = "component_loop_time"
+CONF_SCHEDULER_TIME = "scheduler_time"
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -49,6 +51,18 @@ CONFIG_SCHEMA = {
         accuracy_decimals=0,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    cv.Optional(CONF_COMPONENT_LOOP_TIME): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=0,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_SCHEDULER_TIME): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=0,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
     cv.Optional(CONF_PSRAM): cv.All(
         cv.only_on_esp32,
         cv.requires_component("psram"),
@@ -81,6 +95,16 @@ async def to_code(config):
         sens = await sensor.new_sensor(loop_time_conf)
         cg.add(debug_component.set_loop_time_sensor(sens))
 
+    if component_loop_time_conf := config.get(CONF_COMPONENT_LOOP_TIME):
+        sens = await sensor.new_sensor(component_loop_time_conf)
+        cg.add(debug_component.set_component_loop_time_sensor(sens))
+        cg.add_define("USE_COMPONENT_PROFILER")
+
+    if scheduler_time_conf := config.get(CONF_SCHEDULER_TIME):
+        sens = await sensor.new_sensor(scheduler_time_conf)
+        cg.add(debug_component.set_scheduler_time_sensor(sens))
+        cg.add_define("USE_COMPONENT_PROFILER")
+
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
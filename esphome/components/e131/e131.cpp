@@ -1,6 +1,7 @@
 #include "e131.h"
 #ifdef USE_NETWORK
 #include "e131_addressable_light_effect.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -8,6 +9,9 @@ namespace e131 {
 
 static const char *const TAG = "e131";
 static const int PORT = 5568;
+static const uint8_t MAX_PACKETS_PER_LOOP = 32;
+// E131_NETWORK_DATA_LOSS_TIMEOUT
+static const uint32_t SYNC_TIMEOUT_MS = 2500;
 
 E131Component::E131Component() {}
 
@@ -53,25 +57,36 @@ void E131Component::setup() {
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
-  E131Packet packet;
-  int universe = 0;
   uint8_t buf[1460];
 
-  ssize_t len = this->socket_->read(buf, sizeof(buf));
-  if (len == -1) {
-    return;
-  }
-  payload.resize(len);
-  memmove(&payload[0], buf, len);
-
-  if (!this->packet_(payload, universe, packet)) {
-    ESP_LOGV(TAG, "Invalid packet received of size %zu.", payload.size());
-    return;
+  // Drain all datagrams that arrived since the last loop, keeping only the newest packet of each universe.
+  for (uint8_t i = 0; i < MAX_PACKETS_PER_LOOP; i++) {
+    ssize_t len = this->socket_->read(buf, sizeof(buf));
+    if (len == -1)
+      break;
+    if (!this->packet_(buf, len)) {
+      ESP_LOGV(TAG, "Invalid packet received of size %zd.", len);
+    }
   }
 
-  if (!this->process_(universe, packet)) {
-    ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+  const bool synced = this->sync_received_ && millis() - this->last_sync_ < SYNC_TIMEOUT_MS;
+  for (auto &universe : this->universes_) {
+    if (!universe.pending)
+      continue;
+    // stop waiting for synchronization packets when the source no longer sends them
+    if (universe.sync_address != 0) {
+      if (synced)
+        continue;
+      if (!this->sync_missing_logged_) {
+        ESP_LOGW(TAG, "Universe %d waits for synchronization address %u, but no synchronization packets arrive.",
+                 universe.universe, universe.sync_address);
+        this->sync_missing_logged_ = true;
+      }
+    }
+    universe.pending = false;
+    if (!this->process_(universe.universe, universe.packet)) {
+      ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe.universe, universe.packet.count);
+    }
   }
 }
 
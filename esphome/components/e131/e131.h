@@ -5,7 +5,6 @@
 #include "esphome/core/component.h"
 
 #include <cinttypes>
-#include <map>
 #include <memory>
 #include <set>
 #include <vector>
@@ -24,6 +23,17 @@ struct E131Packet {
   uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
 };
 
+/// A universe with at least one consumer, and the newest packet received for it.
+struct E131Universe {
+  int universe;
+  int consumers;
+  /// A packet has been received since the last time one was applied.
+  bool pending;
+  /// Synchronization address the pending packet waits for, 0 if it is applied at the end of the loop.
+  uint16_t sync_address;
+  E131Packet packet;
+};
+
 class E131Component : public esphome::Component {
  public:
   E131Component();
@@ -39,8 +49,11 @@ class E131Component : public esphome::Component {
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  bool packet_(const uint8_t *data, size_t len);
+  void sync_(uint16_t sync_address);
+  void join_sync_group_(uint16_t sync_address);
   bool process_(int universe, const E131Packet &packet);
+  E131Universe *find_universe_(int universe);
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
@@ -48,8 +61,15 @@ class E131Component : public esphome::Component {
   E131ListenMethod listen_method_{E131_MULTICAST};
   std::unique_ptr<socket::Socket> socket_;
   std::set<E131AddressableLightEffect *> light_effects_;
-  std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  /// Universes with consumers, sorted by universe number.
+  std::vector<E131Universe> universes_;
+  /// Time the last synchronization packet was received, packets only wait for one while they keep coming.
+  uint32_t last_sync_{0};
+  bool sync_received_{false};
+  /// Synchronization address whose multicast group was joined, 0 if none.
+  uint16_t sync_group_{0};
+  /// Whether the missing synchronization packets were logged, reset when one arrives.
+  bool sync_missing_logged_{false};
 };
 
 }  // namespace e131
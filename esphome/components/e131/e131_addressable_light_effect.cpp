@@ -61,28 +61,29 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %" PRId32 "-%d.", get_name().c_str(), universe,
            output_offset, output_end);
 
-  switch (channels_) {
-    case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
-      break;
-
-    case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(
-            Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
-      break;
-
-    case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
-      break;
+  Color colors[light::ADDRESSABLE_LIGHT_CHUNK_SIZE];
+  while (output_offset < output_end) {
+    const int32_t count = std::min(output_end - output_offset, light::ADDRESSABLE_LIGHT_CHUNK_SIZE);
+    switch (channels_) {
+      case E131_MONO:
+        for (int32_t i = 0; i < count; i++, input_data++)
+          colors[i] = Color(input_data[0], input_data[0], input_data[0], input_data[0]);
+        break;
+
+      case E131_RGB:
+        for (int32_t i = 0; i < count; i++, input_data += 3) {
+          colors[i] =
+              Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3);
+        }
+        break;
+
+      case E131_RGBW:
+        for (int32_t i = 0; i < count; i++, input_data += 4)
+          colors[i] = Color(input_data[0], input_data[1], input_data[2], input_data[3]);
+        break;
+    }
+    it->set_pixels(output_offset, colors, count);
+    output_offset += count;
   }
 
   it->schedule_show();
@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <cstring>
 #include "e131.h"
 #ifdef USE_NETWORK
 #include "esphome/components/network/ip_address.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
@@ -17,7 +19,9 @@ static const char *const TAG = "e131";
 
 static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
 static const uint32_t VECTOR_ROOT = 4;
+static const uint32_t VECTOR_ROOT_EXTENDED = 8;
 static const uint32_t VECTOR_FRAME = 2;
+static const uint32_t VECTOR_EXTENDED_SYNCHRONIZATION = 1;
 static const uint8_t VECTOR_DMP = 2;
 
 // E1.31 Packet Structure
@@ -36,7 +40,7 @@ union E131RawPacket {
     uint32_t frame_vector;
     uint8_t source_name[64];
     uint8_t priority;
-    uint16_t reserved;
+    uint16_t sync_address;
     uint8_t sequence_number;
     uint8_t options;
     uint16_t universe;
@@ -54,27 +58,50 @@ union E131RawPacket {
   uint8_t raw[638];
 };
 
+// E1.31 Synchronization Packet Structure
+struct E131RawSyncPacket {
+  // Root Layer
+  uint16_t preamble_size;
+  uint16_t postamble_size;
+  uint8_t acn_id[12];
+  uint16_t root_flength;
+  uint32_t root_vector;
+  uint8_t cid[16];
+
+  // Synchronization Frame Layer
+  uint16_t frame_flength;
+  uint32_t frame_vector;
+  uint8_t sequence_number;
+  uint16_t sync_address;
+  uint16_t reserved;
+} __attribute__((packed));
+
 // We need to have at least one `1` value
 // Get the offset of `property_values[1]`
 const size_t E131_MIN_PACKET_SIZE = reinterpret_cast<size_t>(&((E131RawPacket *) nullptr)->property_values[1]);
 
+E131Universe *E131Component::find_universe_(int universe) {
+  auto it = std::lower_bound(this->universes_.begin(), this->universes_.end(), universe,
+                             [](const E131Universe &a, int b) { return a.universe < b; });
+  if (it == this->universes_.end() || it->universe != universe)
+    return nullptr;
+  return &*it;
+}
+
 bool E131Component::join_igmp_groups_() {
   if (listen_method_ != E131_MULTICAST)
     return false;
   if (this->socket_ == nullptr)
     return false;
 
-  for (auto universe : universe_consumers_) {
-    if (!universe.second)
-      continue;
-
+  for (auto &universe : this->universes_) {
     ip4_addr_t multicast_addr =
-        network::IPAddress(239, 255, ((universe.first >> 8) & 0xff), ((universe.first >> 0) & 0xff));
+        network::IPAddress(239, 255, ((universe.universe >> 8) & 0xff), ((universe.universe >> 0) & 0xff));
 
     auto err = igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr);
 
     if (err) {
-      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe.first);
+      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe.universe);
     }
   }
 
@@ -82,26 +109,37 @@ bool E131Component::join_igmp_groups_() {
 }
 
 void E131Component::join_(int universe) {
-  // store only latest received packet for the given universe
-  auto consumers = ++universe_consumers_[universe];
-
-  if (consumers > 1) {
+  auto *existing = this->find_universe_(universe);
+  if (existing != nullptr) {
+    existing->consumers++;
     return;  // we already joined before
   }
 
+  // store only latest received packet for the given universe
+  auto it = std::lower_bound(this->universes_.begin(), this->universes_.end(), universe,
+                             [](const E131Universe &a, int b) { return a.universe < b; });
+  auto &added = *this->universes_.emplace(it);
+  added.universe = universe;
+  added.consumers = 1;
+  added.pending = false;
+  added.sync_address = 0;
+
   if (join_igmp_groups_()) {
     ESP_LOGD(TAG, "Joined %d universe for E1.31.", universe);
   }
 }
 
 void E131Component::leave_(int universe) {
-  auto consumers = --universe_consumers_[universe];
-
-  if (consumers > 0) {
+  auto *existing = this->find_universe_(universe);
+  if (existing == nullptr)
+    return;
+  if (--existing->consumers > 0) {
     return;  // we have other consumers of the given universe
   }
+  this->universes_.erase(this->universes_.begin() + (existing - this->universes_.data()));
 
-  if (listen_method_ == E131_MULTICAST) {
+  // the group stays joined while synchronization packets are sent to it
+  if (listen_method_ == E131_MULTICAST && universe != this->sync_group_) {
     ip4_addr_t multicast_addr = network::IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff));
 
     igmp_leavegroup(IP4_ADDR_ANY4, &multicast_addr);
@@ -110,14 +148,24 @@ void E131Component::leave_(int universe) {
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
+bool E131Component::packet_(const uint8_t *data, size_t len) {
+  if (len < sizeof(E131RawSyncPacket))
     return false;
 
-  auto *sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+  // parse the packet in the receive buffer, only the property values of wanted universes are copied
+  auto *sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
     return false;
+  if (htonl(sbuff->root_vector) == VECTOR_ROOT_EXTENDED) {
+    auto *sync = reinterpret_cast<const E131RawSyncPacket *>(data);
+    if (htonl(sync->frame_vector) != VECTOR_EXTENDED_SYNCHRONIZATION)
+      return false;
+    this->sync_(htons(sync->sync_address));
+    return true;
+  }
+  if (len < E131_MIN_PACKET_SIZE)
+    return false;
   if (htonl(sbuff->root_vector) != VECTOR_ROOT)
     return false;
   if (htonl(sbuff->frame_vector) != VECTOR_FRAME)
@@ -127,15 +175,59 @@ bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E13
   if (sbuff->property_values[0] != 0)
     return false;
 
-  universe = htons(sbuff->universe);
-  packet.count = htons(sbuff->property_value_count);
-  if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
+  int universe = htons(sbuff->universe);
+  uint16_t count = htons(sbuff->property_value_count);
+  if (count > E131_MAX_PROPERTY_VALUES_COUNT || size_t(sbuff->property_values - data) + count > len)
     return false;
 
-  memcpy(packet.values, sbuff->property_values, packet.count);
+  auto *target = this->find_universe_(universe);
+  if (target == nullptr) {
+    ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, count);
+    return true;
+  }
+  // a newer packet replaces one that hasn't been applied yet
+  target->pending = true;
+  target->sync_address = htons(sbuff->sync_address);
+  if (target->sync_address != 0)
+    this->join_sync_group_(target->sync_address);
+  target->packet.count = count;
+  memcpy(target->packet.values, sbuff->property_values, count);
   return true;
 }
 
+void E131Component::sync_(uint16_t sync_address) {
+  this->last_sync_ = millis();
+  this->sync_received_ = true;
+  this->sync_missing_logged_ = false;
+  // release the packets waiting for this synchronization packet, so they are all applied in the same loop
+  for (auto &universe : this->universes_) {
+    if (universe.pending && universe.sync_address == sync_address)
+      universe.sync_address = 0;
+  }
+}
+
+void E131Component::join_sync_group_(uint16_t sync_address) {
+  if (sync_address == this->sync_group_)
+    return;
+  // Synchronization packets are multicast to the group of the synchronization address, which is not necessarily a
+  // universe we consume
+  if (listen_method_ == E131_MULTICAST) {
+    if (this->sync_group_ != 0 && this->find_universe_(this->sync_group_) == nullptr) {
+      ip4_addr_t old_addr = network::IPAddress(239, 255, ((this->sync_group_ >> 8) & 0xff), (this->sync_group_ & 0xff));
+      igmp_leavegroup(IP4_ADDR_ANY4, &old_addr);
+    }
+    if (this->find_universe_(sync_address) == nullptr) {
+      ip4_addr_t multicast_addr = network::IPAddress(239, 255, ((sync_address >> 8) & 0xff), (sync_address & 0xff));
+      if (igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr)) {
+        ESP_LOGW(TAG, "IGMP join for synchronization address %u of E1.31 failed. Multicast might not work.",
+                 sync_address);
+      }
+    }
+  }
+  this->sync_group_ = sync_address;
+  ESP_LOGD(TAG, "Using synchronization address %u for E1.31.", sync_address);
+}
+
 }  // namespace e131
 }  // namespace esphome
 #endif
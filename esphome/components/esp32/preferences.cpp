@@ -1,6 +1,7 @@
 #ifdef USE_ESP32
 
 #include "esphome/core/preferences.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include <nvs_flash.h>
@@ -14,43 +15,60 @@ namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
-struct NVSData {
-  std::string key;
-  std::vector<uint8_t> data;
-};
+// Minimum time between two NVS writes of the same key on periodic syncs, for keys made with in_flash
+// set and cleared. 0 writes every change on the next sync.
+static uint32_t s_min_write_interval = 0;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_min_write_interval_volatile = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
-static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// FNV-1a over the data, used to detect unchanged values without reading them back from NVS.
+static uint32_t hash_data(const uint8_t *data, size_t len) {
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+class ESP32PreferenceBackend;
+// Backends with data waiting for the next sync, each at most once and in the order they were first saved.
+static std::vector<ESP32PreferenceBackend *> s_pending_save;  // NOLINT
+// All backends, one per key so that saves through different preference objects of a key are coalesced.
+static std::vector<ESP32PreferenceBackend *> s_backends;  // NOLINT
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
   std::string key;
   uint32_t nvs_handle;
+  bool in_flash{true};
+  /// Data to write on the next sync, only valid while pending.
+  std::vector<uint8_t> data;
+  bool pending{false};
+  /// Hash and length of the data in NVS, only valid while stored.
+  uint32_t stored_hash{0};
+  size_t stored_len{0};
+  bool stored{false};
+  /// millis() of the last NVS write of this key, 0 if it has not been written since boot.
+  uint32_t last_write{0};
+
   bool save(const uint8_t *data, size_t len) override {
-    // try find in pending saves and update that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        obj.data.assign(data, data + len);
-        return true;
-      }
+    this->data.assign(data, data + len);
+    if (!this->pending) {
+      this->pending = true;
+      s_pending_save.push_back(this);
+      ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", key.c_str(), len);
     }
-    NVSData save{};
-    save.key = key;
-    save.data.assign(data, data + len);
-    s_pending_save.emplace_back(save);
-    ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", key.c_str(), len);
     return true;
   }
   bool load(uint8_t *data, size_t len) override {
-    // try find in pending saves and load from that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        if (obj.data.size() != len) {
-          // size mismatch
-          return false;
-        }
-        memcpy(data, obj.data.data(), len);
-        return true;
+    // load pending save if there is one
+    if (this->pending) {
+      if (this->data.size() != len) {
+        // size mismatch
+        return false;
       }
+      memcpy(data, this->data.data(), len);
+      return true;
     }
 
     size_t actual_len;
@@ -70,8 +88,46 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
     } else {
       ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key.c_str(), len);
     }
+    this->set_stored_(data, len);
     return true;
   }
+
+  /// Whether the pending data differs from the data in NVS, reads it back only if its hash is not known yet.
+  bool is_changed() {
+    if (!this->stored) {
+      size_t actual_len;
+      esp_err_t err = nvs_get_blob(nvs_handle, key.c_str(), nullptr, &actual_len);
+      if (err != 0) {
+        ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", key.c_str(), esp_err_to_name(err));
+        return true;
+      }
+      std::vector<uint8_t> stored_data(actual_len);
+      err = nvs_get_blob(nvs_handle, key.c_str(), stored_data.data(), &actual_len);
+      if (err != 0) {
+        ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", key.c_str(), esp_err_to_name(err));
+        return true;
+      }
+      this->set_stored_(stored_data.data(), stored_data.size());
+    }
+    return this->stored_len != this->data.size() ||
+           this->stored_hash != hash_data(this->data.data(), this->data.size());
+  }
+  /// Whether a periodic sync has to postpone writing this key.
+  bool is_rate_limited(uint32_t now) const {
+    const uint32_t interval = this->in_flash ? s_min_write_interval : s_min_write_interval_volatile;
+    return this->last_write != 0 && now - this->last_write < interval;
+  }
+  void mark_written(uint32_t now) {
+    this->set_stored_(this->data.data(), this->data.size());
+    this->last_write = now != 0 ? now : 1;
+  }
+
+ protected:
+  void set_stored_(const uint8_t *data, size_t len) {
+    this->stored_hash = hash_data(data, len);
+    this->stored_len = len;
+    this->stored = true;
+  }
 };
 
 class ESP32Preferences : public ESPPreferences {
@@ -95,52 +151,89 @@ class ESP32Preferences : public ESPPreferences {
     }
   }
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
-    return make_preference(length, type);
-  }
-  ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    uint32_t keyval = type;
+    std::string key = str_sprintf("%" PRIu32, keyval);
+    for (auto *pref : s_backends) {
+      if (pref->key == key) {
+        // a key used both in flash and volatile is rate limited as in flash
+        pref->in_flash |= in_flash;
+        return ESPPreferenceObject(pref);
+      }
+    }
+
     auto *pref = new ESP32PreferenceBackend();  // NOLINT(cppcoreguidelines-owning-memory)
     pref->nvs_handle = nvs_handle;
-
-    uint32_t keyval = type;
-    pref->key = str_sprintf("%" PRIu32, keyval);
+    pref->in_flash = in_flash;
+    pref->key = std::move(key);
+    s_backends.push_back(pref);
 
     return ESPPreferenceObject(pref);
   }
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    return make_preference(length, type, true);
+  }
+
+  bool sync() override { return this->sync_(false); }
+  bool sync_periodic() override { return this->sync_(true); }
 
-  bool sync() override {
+  bool reset() override {
+    ESP_LOGD(TAG, "Cleaning up preferences in flash...");
+    for (auto *pref : s_pending_save)
+      pref->pending = false;
+    s_pending_save.clear();
+
+    nvs_flash_deinit();
+    nvs_flash_erase();
+    // Make the handle invalid to prevent any saves until restart
+    nvs_handle = 0;
+    return true;
+  }
+
+ protected:
+  bool sync_(bool periodic) {
     if (s_pending_save.empty())
       return true;
 
     ESP_LOGD(TAG, "Saving %d preferences to flash...", s_pending_save.size());
     // goal try write all pending saves even if one fails
-    int cached = 0, written = 0, failed = 0;
+    int cached = 0, written = 0, failed = 0, postponed = 0;
     esp_err_t last_err = ESP_OK;
     std::string last_key{};
+    const uint32_t now = millis();
 
-    // go through vector from back to front (makes erase easier/more efficient)
-    for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
-      const auto &save = s_pending_save[i];
-      ESP_LOGVV(TAG, "Checking if NVS data %s has changed", save.key.c_str());
-      if (is_changed(nvs_handle, save)) {
-        esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
-        ESP_LOGV(TAG, "sync: key: %s, len: %d", save.key.c_str(), save.data.size());
+    // entries that are not done are moved to the front, keeping the order they were saved in
+    size_t kept = 0;
+    for (auto *save : s_pending_save) {
+      ESP_LOGVV(TAG, "Checking if NVS data %s has changed", save->key.c_str());
+      if (save->is_changed()) {
+        if (periodic && save->is_rate_limited(now)) {
+          ESP_LOGV(TAG, "NVS data %s written recently, postponing", save->key.c_str());
+          postponed++;
+          s_pending_save[kept++] = save;
+          continue;
+        }
+        esp_err_t err = nvs_set_blob(nvs_handle, save->key.c_str(), save->data.data(), save->data.size());
+        ESP_LOGV(TAG, "sync: key: %s, len: %d", save->key.c_str(), save->data.size());
         if (err != 0) {
-          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
+          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save->key.c_str(), save->data.size(),
                    esp_err_to_name(err));
           failed++;
           last_err = err;
-          last_key = save.key;
+          last_key = save->key;
+          s_pending_save[kept++] = save;
           continue;
         }
+        save->mark_written(now);
         written++;
       } else {
-        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.data.size());
+        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save->key.c_str(), save->data.size());
         cached++;
       }
-      s_pending_save.erase(s_pending_save.begin() + i);
+      save->pending = false;
     }
-    ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed", cached + written + failed, cached,
-             written, failed);
+    s_pending_save.resize(kept);
+    ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed, %d postponed",
+             cached + written + failed + postponed, cached, written, failed, postponed);
     if (failed > 0) {
       ESP_LOGE(TAG, "Error saving %d preferences to flash. Last error=%s for key=%s", failed, esp_err_to_name(last_err),
                last_key.c_str());
@@ -155,33 +248,6 @@ class ESP32Preferences : public ESPPreferences {
 
     return failed == 0;
   }
-  bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
-    NVSData stored_data{};
-    size_t actual_len;
-    esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
-    if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", to_save.key.c_str(), esp_err_to_name(err));
-      return true;
-    }
-    stored_data.data.resize(actual_len);
-    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data.data(), &actual_len);
-    if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", to_save.key.c_str(), esp_err_to_name(err));
-      return true;
-    }
-    return to_save.data != stored_data.data;
-  }
-
-  bool reset() override {
-    ESP_LOGD(TAG, "Cleaning up preferences in flash...");
-    s_pending_save.clear();
-
-    nvs_flash_deinit();
-    nvs_flash_erase();
-    // Make the handle invalid to prevent any saves until restart
-    nvs_handle = 0;
-    return true;
-  }
 };
 
 void setup_preferences() {
@@ -190,6 +256,11 @@ void setup_preferences() {
   global_preferences = prefs;
 }
 
+void set_preferences_min_write_interval(uint32_t interval, uint32_t volatile_interval) {
+  s_min_write_interval = interval;
+  s_min_write_interval_volatile = volatile_interval;
+}
+
 }  // namespace esp32
 
 ESPPreferences *global_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
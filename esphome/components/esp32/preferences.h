@@ -1,10 +1,15 @@
 #pragma once
 #ifdef USE_ESP32
 
+#include <cstdint>
+
 namespace esphome {
 namespace esp32 {
 
 void setup_preferences();
+/// Set the minimum time in ms between NVS writes of the same key on periodic syncs, for keys made with in_flash set
+/// and cleared.
+void set_preferences_min_write_interval(uint32_t interval, uint32_t volatile_interval);
 
 }  // namespace esp32
 }  // namespace esphome
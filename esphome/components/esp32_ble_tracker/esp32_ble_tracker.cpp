@@ -7,6 +7,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 #include <esp_bt.h>
 #include <esp_bt_defs.h>
 #include <esp_bt_main.h>
@@ -135,12 +137,29 @@ void ESP32BLETracker::loop() {
       }
 
       if (this->parse_advertisements_) {
+        if (this->listener_index_dirty_)
+          this->rebuild_listener_index_();
         for (size_t i = 0; i < index; i++) {
+          const auto &result = this->scan_result_buffer_[i];
+          const uint64_t address = esp32_ble::ble_addr_to_uint64(result.bda);
+          auto matched = this->address_listeners_.find(address);
+          if (matched == this->address_listeners_.end() && this->unfiltered_listeners_.empty() &&
+              this->clients_.empty() && (this->scan_continuous_ || this->is_already_discovered_(address))) {
+            // nobody is interested in this device and it won't be printed, skip parsing it
+            continue;
+          }
+
           ESPBTDevice device;
-          device.parse_scan_rst(this->scan_result_buffer_[i]);
+          device.parse_scan_rst(result);
 
           bool found = false;
-          for (auto *listener : this->listeners_) {
+          if (matched != this->address_listeners_.end()) {
+            for (auto *listener : matched->second) {
+              if (listener->parse_device(device))
+                found = true;
+            }
+          }
+          for (auto *listener : this->unfiltered_listeners_) {
             if (listener->parse_device(device))
               found = true;
           }
@@ -339,9 +358,43 @@ void ESP32BLETracker::register_listener(ESPBTDeviceListener *listener) {
   this->recalculate_advertisement_parser_types();
 }
 
+void ESPBTDeviceListener::add_address_filter(uint64_t address) {
+  this->address_filters_.push_back(address);
+  if (this->parent_ != nullptr)
+    this->parent_->invalidate_listener_index();
+}
+
+void ESP32BLETracker::rebuild_listener_index_() {
+  // Address filters are usually set after a listener is registered, so the index is built on first use
+  this->address_listeners_.clear();
+  this->unfiltered_listeners_.clear();
+  for (auto *listener : this->listeners_) {
+    // listeners in raw mode get the advertisements through parse_devices()
+    if (listener->get_advertisement_parser_type() != AdvertisementParserType::PARSED_ADVERTISEMENTS)
+      continue;
+    const auto &filters = listener->get_address_filters();
+    if (filters.empty()) {
+      this->unfiltered_listeners_.push_back(listener);
+      continue;
+    }
+    for (uint64_t address : filters) {
+      auto &listeners = this->address_listeners_[address];
+      if (std::find(listeners.begin(), listeners.end(), listener) == listeners.end())
+        listeners.push_back(listener);
+    }
+  }
+  this->listener_index_dirty_ = false;
+}
+
+bool ESP32BLETracker::is_already_discovered_(uint64_t address) const {
+  return std::find(this->already_discovered_.begin(), this->already_discovered_.end(), address) !=
+         this->already_discovered_.end();
+}
+
 void ESP32BLETracker::recalculate_advertisement_parser_types() {
   this->raw_advertisements_ = false;
   this->parse_advertisements_ = false;
+  this->listener_index_dirty_ = true;
   for (auto *listener : this->listeners_) {
     if (listener->get_advertisement_parser_type() == AdvertisementParserType::PARSED_ADVERTISEMENTS) {
       this->parse_advertisements_ = true;
@@ -437,6 +490,14 @@ optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceData
     return {};
   return ESPBLEiBeacon(data.data.data());
 }
+optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceDataView &data) {
+  if (!data.uuid.contains(0x4C, 0x00))
+    return {};
+
+  if (data.length != 23)
+    return {};
+  return ESPBLEiBeacon(data.data);
+}
 
 void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   this->scan_result_ = param;
@@ -444,9 +505,18 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
     this->address_[i] = param.bda[i];
   this->address_type_ = param.ble_addr_type;
   this->rssi_ = param.rssi;
-  this->parse_adv_(param);
+  // the advertisement data is only parsed when it's first accessed
+  this->parsed_ = false;
+  this->name_.clear();
+  this->tx_powers_.clear();
+  this->appearance_.reset();
+  this->ad_flag_.reset();
+  this->service_uuids_.clear();
+  this->manufacturer_datas_.clear();
+  this->service_datas_.clear();
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+  this->ensure_parsed_();
   ESP_LOGVV(TAG, "Parse Result:");
   const char *address_type;
   switch (this->address_type_) {
@@ -505,30 +575,141 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "  Adv data: %s", format_hex_pretty(param.ble_adv, param.adv_data_len + param.scan_rsp_len).c_str());
 #endif
 }
-void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
+// See also Generic Access Profile Assigned Numbers:
+// https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
+// RESPONSE DATA FORMAT: https://www.bluetooth.com/specifications/bluetooth-core-specification/ (vol 3, part C, 11)
+// See also Core Specification Supplement: https://www.bluetooth.com/specifications/bluetooth-core-specification/
+// (called CSS here)
+
+uint8_t ESPBTAdvRecord::get_service_uuid_count() const {
+  // CSS 1.1 SERVICE UUID
+  // The Service UUID data type is used to include a list of Service or Service Class UUIDs.
+  // There are six data types defined for the three sizes of Service UUIDs that may be returned:
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_16SRV_CMPL:
+    case ESP_BLE_AD_TYPE_16SRV_PART:
+      // • 16-bit Bluetooth Service UUIDs
+      return this->length / 2;
+    case ESP_BLE_AD_TYPE_32SRV_CMPL:
+    case ESP_BLE_AD_TYPE_32SRV_PART:
+      // • 32-bit Bluetooth Service UUIDs
+      return this->length / 4;
+    case ESP_BLE_AD_TYPE_128SRV_CMPL:
+    case ESP_BLE_AD_TYPE_128SRV_PART:
+      // • Global 128-bit Service UUIDs
+      return this->length / 16;
+    default:
+      return 0;
+  }
+}
+
+ESPBTUUID ESPBTAdvRecord::get_service_uuid(uint8_t index) const {
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_16SRV_CMPL:
+    case ESP_BLE_AD_TYPE_16SRV_PART:
+      return ESPBTUUID::from_uint16(encode_uint16(this->data[2 * index + 1], this->data[2 * index]));
+    case ESP_BLE_AD_TYPE_32SRV_CMPL:
+    case ESP_BLE_AD_TYPE_32SRV_PART:
+      return ESPBTUUID::from_uint32(encode_uint32(this->data[4 * index + 3], this->data[4 * index + 2],
+                                                  this->data[4 * index + 1], this->data[4 * index]));
+    default:
+      return ESPBTUUID::from_raw(this->data + 16 * index);
+  }
+}
+
+bool ESPBTAdvRecord::get_service_data(ServiceDataView &out) const {
+  // CSS 1.11 SERVICE DATA
+  // "The Service Data data type consists of a service UUID with the data associated with that service."
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  uint8_t uuid_length;
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      // «Service Data - 16 bit UUID»
+      // The first 2 octets contain the 16 bit Service UUID followed by additional service data
+      uuid_length = 2;
+      break;
+    case ESP_BLE_AD_TYPE_32SERVICE_DATA:
+      // «Service Data - 32 bit UUID»
+      // The first 4 octets contain the 32 bit Service UUID followed by additional service data
+      uuid_length = 4;
+      break;
+    case ESP_BLE_AD_TYPE_128SERVICE_DATA:
+      // «Service Data - 128 bit UUID»
+      // The first 16 octets contain the 128 bit Service UUID followed by additional service data
+      uuid_length = 16;
+      break;
+    default:
+      return false;
+  }
+  if (this->length < uuid_length) {
+    ESP_LOGV(TAG, "Record length too small for service data type 0x%02x", this->type);
+    return false;
+  }
+  if (uuid_length == 2) {
+    out.uuid = ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0]));
+  } else if (uuid_length == 4) {
+    out.uuid = ESPBTUUID::from_uint32(encode_uint32(this->data[3], this->data[2], this->data[1], this->data[0]));
+  } else {
+    out.uuid = ESPBTUUID::from_raw(this->data);
+  }
+  out.data = this->data + uuid_length;
+  out.length = this->length - uuid_length;
+  return true;
+}
 
-  while (offset + 2 < len) {
-    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
-    if (field_length == 0) {
-      continue;  // Possible zero padded advertisement data
+bool ESPBTAdvRecord::get_manufacturer_data(ServiceDataView &out) const {
+  // CSS 1.4 MANUFACTURER SPECIFIC DATA
+  // "The Manufacturer Specific data type is used for manufacturer specific data. The first two data octets shall
+  // contain a company identifier from Assigned Numbers. The interpretation of any other octets within the data
+  // shall be defined by the manufacturer specified by the company identifier."
+  // CSS 1: Optional in this context (may appear more than once in a block).
+  if (this->type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE)
+    return false;
+  if (this->length < 2) {
+    ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE");
+    return false;
+  }
+  out.uuid = ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0]));
+  out.data = this->data + 2;
+  out.length = this->length - 2;
+  return true;
+}
+
+bool ESPBTDevice::has_service_uuid(const ESPBTUUID &uuid) const {
+  for (auto record : this->get_adv_records()) {
+    const uint8_t count = record.get_service_uuid_count();
+    for (uint8_t i = 0; i < count; i++) {
+      if (record.get_service_uuid(i) == uuid)
+        return true;
     }
+  }
+  return false;
+}
 
-    // first byte of adv record is adv record type
-    const uint8_t record_type = payload[offset++];
-    const uint8_t *record = &payload[offset];
-    const uint8_t record_length = field_length - 1;
-    offset += record_length;
+optional<ServiceDataView> ESPBTDevice::find_service_data(const ESPBTUUID &uuid) const {
+  ServiceDataView data;
+  for (auto record : this->get_adv_records()) {
+    if (record.get_service_data(data) && data.uuid == uuid)
+      return data;
+  }
+  return {};
+}
 
-    // See also Generic Access Profile Assigned Numbers:
-    // https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
-    // RESPONSE DATA FORMAT: https://www.bluetooth.com/specifications/bluetooth-core-specification/ (vol 3, part C, 11)
-    // See also Core Specification Supplement: https://www.bluetooth.com/specifications/bluetooth-core-specification/
-    // (called CSS here)
+optional<ServiceDataView> ESPBTDevice::find_manufacturer_data(const ESPBTUUID &uuid) const {
+  ServiceDataView data;
+  for (auto record : this->get_adv_records()) {
+    if (record.get_manufacturer_data(data) && data.uuid == uuid)
+      return data;
+  }
+  return {};
+}
 
-    switch (record_type) {
+void ESPBTDevice::parse_adv_() const {
+  this->parsed_ = true;
+  ServiceDataView data;
+  for (auto record : this->get_adv_records()) {
+    switch (record.type) {
       case ESP_BLE_AD_TYPE_NAME_SHORT:
       case ESP_BLE_AD_TYPE_NAME_CMPL: {
         // CSS 1.2 LOCAL NAME
@@ -537,8 +718,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // SHORTENED LOCAL NAME
         // "The Shortened Local Name data type defines a shortened version of the Local Name data type. The Shortened
         // Local Name data type shall not be used to advertise a name that is longer than the Local Name data type."
-        if (record_length > this->name_.length()) {
-          this->name_ = std::string(reinterpret_cast<const char *>(record), record_length);
+        if (record.length > this->name_.length()) {
+          this->name_.assign(reinterpret_cast<const char *>(record.data), record.length);
         }
         break;
       }
@@ -546,7 +727,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // CSS 1.5 TX POWER LEVEL
         // "The TX Power Level data type indicates the transmitted power level of the packet containing the data type."
         // CSS 1: Optional in this context (may appear more than once in a block).
-        this->tx_powers_.push_back(*payload);
+        if (record.length >= 1)
+          this->tx_powers_.push_back(static_cast<int8_t>(record.data[0]));
         break;
       }
       case ESP_BLE_AD_TYPE_APPEARANCE: {
@@ -555,7 +737,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // See also https://www.bluetooth.com/specifications/gatt/characteristics/
         // CSS 1: Optional in this context; shall not appear more than once in a block and shall not appear in both
         // the AD and SRD of the same extended advertising interval.
-        this->appearance_ = *reinterpret_cast<const uint16_t *>(record);
+        if (record.length >= 2)
+          this->appearance_ = encode_uint16(record.data[1], record.data[0]);
         break;
       }
       case ESP_BLE_AD_TYPE_FLAG: {
@@ -564,102 +747,38 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // Flag bits are non-zero and the advertising packet is connectable, otherwise the Flags data type may be
         // omitted."
         // CSS 1: Optional in this context; shall not appear more than once in a block.
-        this->ad_flag_ = *record;
+        if (record.length >= 1)
+          this->ad_flag_ = record.data[0];
         break;
       }
-      // CSS 1.1 SERVICE UUID
-      // The Service UUID data type is used to include a list of Service or Service Class UUIDs.
-      // There are six data types defined for the three sizes of Service UUIDs that may be returned:
-      // CSS 1: Optional in this context (may appear more than once in a block).
       case ESP_BLE_AD_TYPE_16SRV_CMPL:
-      case ESP_BLE_AD_TYPE_16SRV_PART: {
-        // • 16-bit Bluetooth Service UUIDs
-        for (uint8_t i = 0; i < record_length / 2; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record + 2 * i)));
-        }
-        break;
-      }
+      case ESP_BLE_AD_TYPE_16SRV_PART:
       case ESP_BLE_AD_TYPE_32SRV_CMPL:
-      case ESP_BLE_AD_TYPE_32SRV_PART: {
-        // • 32-bit Bluetooth Service UUIDs
-        for (uint8_t i = 0; i < record_length / 4; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record + 4 * i)));
-        }
-        break;
-      }
+      case ESP_BLE_AD_TYPE_32SRV_PART:
       case ESP_BLE_AD_TYPE_128SRV_CMPL:
       case ESP_BLE_AD_TYPE_128SRV_PART: {
-        // • Global 128-bit Service UUIDs
-        this->service_uuids_.push_back(ESPBTUUID::from_raw(record));
+        const uint8_t count = record.get_service_uuid_count();
+        for (uint8_t i = 0; i < count; i++)
+          this->service_uuids_.push_back(record.get_service_uuid(i));
         break;
       }
       case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE: {
-        // CSS 1.4 MANUFACTURER SPECIFIC DATA
-        // "The Manufacturer Specific data type is used for manufacturer specific data. The first two data octets shall
-        // contain a company identifier from Assigned Numbers. The interpretation of any other octets within the data
-        // shall be defined by the manufacturer specified by the company identifier."
-        // CSS 1: Optional in this context (may appear more than once in a block).
-        if (record_length < 2) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->manufacturer_datas_.push_back(data);
-        break;
-      }
-
-      // CSS 1.11 SERVICE DATA
-      // "The Service Data data type consists of a service UUID with the data associated with that service."
-      // CSS 1: Optional in this context (may appear more than once in a block).
-      case ESP_BLE_AD_TYPE_SERVICE_DATA: {
-        // «Service Data - 16 bit UUID»
-        // Size: 2 or more octets
-        // The first 2 octets contain the 16 bit Service UUID fol- lowed by additional service data
-        if (record_length < 2) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->service_datas_.push_back(data);
-        break;
-      }
-      case ESP_BLE_AD_TYPE_32SERVICE_DATA: {
-        // «Service Data - 32 bit UUID»
-        // Size: 4 or more octets
-        // The first 4 octets contain the 32 bit Service UUID fol- lowed by additional service data
-        if (record_length < 4) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_32SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record));
-        data.data.assign(record + 4UL, record + record_length);
-        this->service_datas_.push_back(data);
+        if (record.get_manufacturer_data(data))
+          this->manufacturer_datas_.push_back(data.to_service_data());
         break;
       }
+      case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      case ESP_BLE_AD_TYPE_32SERVICE_DATA:
       case ESP_BLE_AD_TYPE_128SERVICE_DATA: {
-        // «Service Data - 128 bit UUID»
-        // Size: 16 or more octets
-        // The first 16 octets contain the 128 bit Service UUID followed by additional service data
-        if (record_length < 16) {
-          ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_128SERVICE_DATA");
-          break;
-        }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_raw(record);
-        data.data.assign(record + 16UL, record + record_length);
-        this->service_datas_.push_back(data);
+        if (record.get_service_data(data))
+          this->service_datas_.push_back(data.to_service_data());
         break;
       }
       case ESP_BLE_AD_TYPE_INT_RANGE:
         // Avoid logging this as it's very verbose
         break;
       default: {
-        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record_type);
+        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record.type);
         break;
       }
     }
@@ -733,6 +852,9 @@ bool ESPBTDevice::resolve_irk(const uint8_t *irk) const {
   uint8_t ecb_ciphertext[16];
 
   uint64_t addr64 = esp32_ble::ble_addr_to_uint64(this->address_);
+  // Only resolvable private addresses (two most significant bits 0b01) can match, skip the AES for all others
+  if (((addr64 >> 46) & 0x03) != 0x01)
+    return false;
 
   memcpy(&ecb_key, irk, 16);
   memset(&ecb_plaintext, 0, 16);
@@ -7,6 +7,7 @@
 
 #include <array>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #ifdef USE_ESP32
@@ -38,11 +39,82 @@ struct ServiceData {
   adv_data_t data;
 };
 
+/// Service or manufacturer data pointing into the raw advertisement data of an ESPBTDevice.
+struct ServiceDataView {
+  ESPBTUUID uuid;
+  const uint8_t *data{nullptr};
+  uint8_t length{0};
+
+  adv_data_t to_vector() const { return adv_data_t(this->data, this->data + this->length); }
+  ServiceData to_service_data() const { return ServiceData{this->uuid, this->to_vector()}; }
+};
+
+/// A single AD structure of an advertisement, pointing into the raw advertisement data.
+struct ESPBTAdvRecord {
+  uint8_t type;
+  const uint8_t *data;
+  uint8_t length;
+
+  /// Number of service UUIDs if this is one of the service UUID list types, 0 otherwise.
+  uint8_t get_service_uuid_count() const;
+  ESPBTUUID get_service_uuid(uint8_t index) const;
+  /// Parse a service data record (16, 32 or 128 bit UUID), returns false for other types or short records.
+  bool get_service_data(ServiceDataView &out) const;
+  /// Parse a manufacturer specific data record, returns false for other types or short records.
+  bool get_manufacturer_data(ServiceDataView &out) const;
+};
+
+/** Iterates over the AD structures in raw advertisement data without copying anything.
+ *
+ * Zero length padding is skipped and iteration stops at the first structure that doesn't fit in the data.
+ */
+class ESPBTAdvRecords {
+ public:
+  class Iterator {
+   public:
+    Iterator(const uint8_t *data, uint8_t len, uint8_t offset) : data_(data), len_(len), offset_(offset) {
+      this->skip_padding_();
+    }
+    ESPBTAdvRecord operator*() const {
+      return {this->data_[this->offset_ + 1], this->data_ + this->offset_ + 2,
+              static_cast<uint8_t>(this->data_[this->offset_] - 1)};
+    }
+    Iterator &operator++() {
+      this->offset_ += this->data_[this->offset_] + 1;
+      this->skip_padding_();
+      return *this;
+    }
+    bool operator!=(const Iterator &other) const { return this->offset_ != other.offset_; }
+
+   protected:
+    void skip_padding_() {
+      while (this->offset_ < this->len_ && this->data_[this->offset_] == 0)
+        this->offset_++;
+      // stop at a truncated structure
+      if (this->offset_ < this->len_ && this->offset_ + this->data_[this->offset_] >= this->len_)
+        this->offset_ = this->len_;
+    }
+
+    const uint8_t *data_;
+    uint8_t len_;
+    uint8_t offset_;
+  };
+
+  ESPBTAdvRecords(const uint8_t *data, uint8_t len) : data_(data), len_(len) {}
+  Iterator begin() const { return Iterator(this->data_, this->len_, 0); }
+  Iterator end() const { return Iterator(this->data_, this->len_, this->len_); }
+
+ protected:
+  const uint8_t *data_;
+  uint8_t len_;
+};
+
 class ESPBLEiBeacon {
  public:
   ESPBLEiBeacon() { memset(&this->beacon_data_, 0, sizeof(this->beacon_data_)); }
   ESPBLEiBeacon(const uint8_t *data);
   static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceData &data);
+  static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceDataView &data);
 
   uint16_t get_major() { return byteswap(this->beacon_data_.major); }
   uint16_t get_minor() { return byteswap(this->beacon_data_.minor); }
@@ -60,6 +132,12 @@ class ESPBLEiBeacon {
   } PACKED beacon_data_;
 };
 
+/** A received advertisement.
+ *
+ * The name, service UUIDs and service/manufacturer datas are only copied out of the raw advertisement data when one
+ * of their getters is called for the first time. Listeners that see many advertisements should prefer
+ * get_adv_records() and the find_*() helpers, which work on the raw data directly.
+ */
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -72,25 +150,58 @@ class ESPBTDevice {
 
   esp_ble_addr_type_t get_address_type() const { return this->address_type_; }
   int get_rssi() const { return rssi_; }
-  const std::string &get_name() const { return this->name_; }
+  const std::string &get_name() const {
+    this->ensure_parsed_();
+    return this->name_;
+  }
 
-  const std::vector<int8_t> &get_tx_powers() const { return tx_powers_; }
+  const std::vector<int8_t> &get_tx_powers() const {
+    this->ensure_parsed_();
+    return tx_powers_;
+  }
 
-  const optional<uint16_t> &get_appearance() const { return appearance_; }
-  const optional<uint8_t> &get_ad_flag() const { return ad_flag_; }
-  const std::vector<ESPBTUUID> &get_service_uuids() const { return service_uuids_; }
+  const optional<uint16_t> &get_appearance() const {
+    this->ensure_parsed_();
+    return appearance_;
+  }
+  const optional<uint8_t> &get_ad_flag() const {
+    this->ensure_parsed_();
+    return ad_flag_;
+  }
+  const std::vector<ESPBTUUID> &get_service_uuids() const {
+    this->ensure_parsed_();
+    return service_uuids_;
+  }
 
-  const std::vector<ServiceData> &get_manufacturer_datas() const { return manufacturer_datas_; }
+  const std::vector<ServiceData> &get_manufacturer_datas() const {
+    this->ensure_parsed_();
+    return manufacturer_datas_;
+  }
 
-  const std::vector<ServiceData> &get_service_datas() const { return service_datas_; }
+  const std::vector<ServiceData> &get_service_datas() const {
+    this->ensure_parsed_();
+    return service_datas_;
+  }
 
   const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &get_scan_result() const { return scan_result_; }
 
+  /// The AD structures of the advertisement and scan response, pointing into get_scan_result().
+  ESPBTAdvRecords get_adv_records() const {
+    const auto &result = this->scan_result_;
+    return ESPBTAdvRecords(result.ble_adv, result.adv_data_len + result.scan_rsp_len);
+  }
+  bool has_service_uuid(const ESPBTUUID &uuid) const;
+  optional<ServiceDataView> find_service_data(const ESPBTUUID &uuid) const;
+  optional<ServiceDataView> find_manufacturer_data(const ESPBTUUID &uuid) const;
+
   bool resolve_irk(const uint8_t *irk) const;
 
   optional<ESPBLEiBeacon> get_ibeacon() const {
-    for (auto &it : this->manufacturer_datas_) {
-      auto res = ESPBLEiBeacon::from_manufacturer_data(it);
+    ServiceDataView data;
+    for (auto record : this->get_adv_records()) {
+      if (!record.get_manufacturer_data(data))
+        continue;
+      auto res = ESPBLEiBeacon::from_manufacturer_data(data);
       if (res.has_value())
         return *res;
     }
@@ -98,20 +209,25 @@ class ESPBTDevice {
   }
 
  protected:
-  void parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  void ensure_parsed_() const {
+    if (!this->parsed_)
+      this->parse_adv_();
+  }
+  void parse_adv_() const;
 
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
-  std::vector<int8_t> tx_powers_{};
-  optional<uint16_t> appearance_{};
-  optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_{};
-  std::vector<ServiceData> manufacturer_datas_{};
-  std::vector<ServiceData> service_datas_{};
+  mutable bool parsed_{false};
+  mutable std::string name_{};
+  mutable std::vector<int8_t> tx_powers_{};
+  mutable optional<uint16_t> appearance_{};
+  mutable optional<uint8_t> ad_flag_{};
+  mutable std::vector<ESPBTUUID> service_uuids_{};
+  mutable std::vector<ServiceData> manufacturer_datas_{};
+  mutable std::vector<ServiceData> service_datas_{};
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_{};
 };
 
@@ -129,8 +245,17 @@ class ESPBTDeviceListener {
   };
   void set_parent(ESP32BLETracker *parent) { parent_ = parent; }
 
+  /** Only pass advertisements from \p address to parse_device().
+   *
+   * Can be called several times to receive advertisements from several addresses. Listeners without any address
+   * filter receive every advertisement.
+   */
+  void add_address_filter(uint64_t address);
+  const std::vector<uint64_t> &get_address_filters() const { return this->address_filters_; }
+
  protected:
   ESP32BLETracker *parent_{nullptr};
+  std::vector<uint64_t> address_filters_;
 };
 
 enum class ClientState {
@@ -203,6 +328,8 @@ class ESP32BLETracker : public Component,
   void register_listener(ESPBTDeviceListener *listener);
   void register_client(ESPBTClient *client);
   void recalculate_advertisement_parser_types();
+  /// Rebuild the listener index before the next advertisement, after a listener changed its address filters.
+  void invalidate_listener_index() { this->listener_index_dirty_ = true; }
 
   void print_bt_device_info(const ESPBTDevice &device);
 
@@ -228,12 +355,19 @@ class ESP32BLETracker : public Component,
   void gap_scan_start_complete_(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT` event is received.
   void gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param);
+  /// Rebuild the lookup of the listeners by the addresses they filter on.
+  void rebuild_listener_index_();
+  bool is_already_discovered_(uint64_t address) const;
 
   int app_id_{0};
 
   /// Vector of addresses that have already been printed in print_bt_device_info
   std::vector<uint64_t> already_discovered_;
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// Listeners with address filters by address, so an advertisement is only parsed if someone is interested.
+  std::unordered_map<uint64_t, std::vector<ESPBTDeviceListener *>> address_listeners_;
+  std::vector<ESPBTDeviceListener *> unfiltered_listeners_;
+  bool listener_index_dirty_{true};
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
   /// A structure holding the ESP BLE scan parameters.
@@ -1,4 +1,5 @@
 #include "led_strip.h"
+#include <algorithm>
 #include <cinttypes>
 
 #ifdef USE_ESP32
@@ -21,6 +22,131 @@ static const uint32_t RMT_CLK_FREQ = 80000000;
 static const uint8_t RMT_CLK_DIV = 2;
 #endif
 
+#if ESP_IDF_VERSION_MAJOR >= 5
+/// RMT encoder converting the pixel bytes to symbols while they are sent, followed by the reset symbol.
+struct LedStripEncoder {
+  rmt_encoder_t base;  // must be the first member
+  rmt_encoder_handle_t bytes_encoder;
+  rmt_encoder_handle_t copy_encoder;
+  rmt_symbol_word_t reset;
+  bool send_reset;
+  bool sending_reset;
+};
+
+static size_t IRAM_ATTR encode_led_strip(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                                         const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state) {
+  auto *led_encoder = reinterpret_cast<LedStripEncoder *>(encoder);
+  rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+  int state = RMT_ENCODING_RESET;
+  size_t encoded_symbols = 0;
+
+  if (!led_encoder->sending_reset) {
+    auto *bytes_encoder = led_encoder->bytes_encoder;
+    encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, primary_data, data_size, &session_state);
+    if (session_state & RMT_ENCODING_COMPLETE)
+      led_encoder->sending_reset = true;
+    if (session_state & RMT_ENCODING_MEM_FULL) {
+      // the RMT memory is full, continue in the next call once the driver made room
+      *ret_state = static_cast<rmt_encode_state_t>(state | RMT_ENCODING_MEM_FULL);
+      return encoded_symbols;
+    }
+  }
+
+  if (led_encoder->send_reset) {
+    auto *copy_encoder = led_encoder->copy_encoder;
+    encoded_symbols +=
+        copy_encoder->encode(copy_encoder, channel, &led_encoder->reset, sizeof(led_encoder->reset), &session_state);
+    if (session_state & RMT_ENCODING_MEM_FULL) {
+      *ret_state = static_cast<rmt_encode_state_t>(state | RMT_ENCODING_MEM_FULL);
+      return encoded_symbols;
+    }
+  }
+  led_encoder->sending_reset = false;
+  *ret_state = static_cast<rmt_encode_state_t>(state | RMT_ENCODING_COMPLETE);
+  return encoded_symbols;
+}
+
+static esp_err_t reset_led_strip_encoder(rmt_encoder_t *encoder) {
+  auto *led_encoder = reinterpret_cast<LedStripEncoder *>(encoder);
+  rmt_encoder_reset(led_encoder->bytes_encoder);
+  rmt_encoder_reset(led_encoder->copy_encoder);
+  led_encoder->sending_reset = false;
+  return ESP_OK;
+}
+
+static esp_err_t del_led_strip_encoder(rmt_encoder_t *encoder) {
+  auto *led_encoder = reinterpret_cast<LedStripEncoder *>(encoder);
+  if (led_encoder->bytes_encoder != nullptr)
+    rmt_del_encoder(led_encoder->bytes_encoder);
+  if (led_encoder->copy_encoder != nullptr)
+    rmt_del_encoder(led_encoder->copy_encoder);
+  delete led_encoder;  // NOLINT(cppcoreguidelines-owning-memory)
+  return ESP_OK;
+}
+
+static esp_err_t new_led_strip_encoder(const rmt_symbol_word_t &bit0, const rmt_symbol_word_t &bit1,
+                                       const rmt_symbol_word_t &reset, rmt_encoder_handle_t *ret_encoder) {
+  auto *led_encoder = new LedStripEncoder();  // NOLINT(cppcoreguidelines-owning-memory)
+  led_encoder->base.encode = encode_led_strip;
+  led_encoder->base.reset = reset_led_strip_encoder;
+  led_encoder->base.del = del_led_strip_encoder;
+  led_encoder->reset = reset;
+  led_encoder->send_reset = reset.duration0 > 0 || reset.duration1 > 0;
+
+  rmt_bytes_encoder_config_t bytes_config;
+  memset(&bytes_config, 0, sizeof(bytes_config));
+  bytes_config.bit0 = bit0;
+  bytes_config.bit1 = bit1;
+  bytes_config.flags.msb_first = 1;
+  rmt_copy_encoder_config_t copy_config;
+  memset(&copy_config, 0, sizeof(copy_config));
+  esp_err_t err = rmt_new_bytes_encoder(&bytes_config, &led_encoder->bytes_encoder);
+  if (err == ESP_OK)
+    err = rmt_new_copy_encoder(&copy_config, &led_encoder->copy_encoder);
+  if (err != ESP_OK) {
+    del_led_strip_encoder(&led_encoder->base);
+    return err;
+  }
+  *ret_encoder = &led_encoder->base;
+  return ESP_OK;
+}
+#else
+void IRAM_ATTR ESP32RMTLEDStripLightOutput::translate_(const void *src, rmt_item32_t *dest, size_t src_size,
+                                                       size_t wanted_num, size_t *translated_size, size_t *item_num) {
+  ESP32RMTLEDStripLightOutput *self;
+  if (src == nullptr || dest == nullptr ||
+      rmt_translator_get_context(item_num, reinterpret_cast<void **>(&self)) != ESP_OK) {
+    *translated_size = 0;
+    *item_num = 0;
+    return;
+  }
+  // The legacy driver takes a block with fewer than wanted_num items as the end of the data, so blocks are always
+  // filled while data remains. With a reset, write_state() passes one byte more than the pixel data; that last byte
+  // is never read and stands for the reset symbol, which then gets a block of its own if the data filled the last one.
+  const bool send_reset = self->reset_.duration0 > 0 || self->reset_.duration1 > 0;
+  const size_t data_size = send_reset ? src_size - 1 : src_size;
+  const size_t count = std::min(data_size, wanted_num / 8);
+
+  const auto *psrc = static_cast<const uint8_t *>(src);
+  rmt_item32_t *pdest = dest;
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t b = psrc[i];
+    for (int bit = 7; bit >= 0; bit--) {
+      pdest->val = b & (1 << bit) ? self->bit1_.val : self->bit0_.val;
+      pdest++;
+    }
+  }
+  size_t translated = count;
+  if (send_reset && count == data_size && size_t(pdest - dest) < wanted_num) {
+    pdest->val = self->reset_.val;
+    pdest++;
+    translated++;
+  }
+  *translated_size = translated;
+  *item_num = pdest - dest;
+}
+#endif
+
 void ESP32RMTLEDStripLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 LED Strip...");
 
@@ -35,6 +161,13 @@ void ESP32RMTLEDStripLightOutput::setup() {
   }
   memset(this->buf_, 0, buffer_size);
 
+  this->tx_buf_ = allocator.allocate(buffer_size);
+  if (this->tx_buf_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate LED transmit buffer!");
+    this->mark_failed();
+    return;
+  }
+
   this->effect_data_ = allocator.allocate(this->num_leds_);
   if (this->effect_data_ == nullptr) {
     ESP_LOGE(TAG, "Cannot allocate effect data!");
@@ -43,11 +176,6 @@ void ESP32RMTLEDStripLightOutput::setup() {
   }
 
 #if ESP_IDF_VERSION_MAJOR >= 5
-  RAMAllocator<rmt_symbol_word_t> rmt_allocator(this->use_psram_ ? 0 : RAMAllocator<rmt_symbol_word_t>::ALLOC_INTERNAL);
-
-  // 8 bits per byte, 1 rmt_symbol_word_t per bit + 1 rmt_symbol_word_t for reset
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8 + 1);
-
   rmt_tx_channel_config_t channel;
   memset(&channel, 0, sizeof(channel));
   channel.clk_src = RMT_CLK_SRC_DEFAULT;
@@ -66,9 +194,7 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 
-  rmt_copy_encoder_config_t encoder;
-  memset(&encoder, 0, sizeof(encoder));
-  if (rmt_new_copy_encoder(&encoder, &this->encoder_) != ESP_OK) {
+  if (new_led_strip_encoder(this->bit0_, this->bit1_, this->reset_, &this->encoder_) != ESP_OK) {
     ESP_LOGE(TAG, "Encoder creation failed");
     this->mark_failed();
     return;
@@ -80,11 +206,6 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 #else
-  RAMAllocator<rmt_item32_t> rmt_allocator(this->use_psram_ ? 0 : RAMAllocator<rmt_item32_t>::ALLOC_INTERNAL);
-
-  // 8 bits per byte, 1 rmt_item32_t per bit + 1 rmt_item32_t for reset
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8 + 1);
-
   rmt_config_t config;
   memset(&config, 0, sizeof(config));
   config.channel = this->channel_;
@@ -108,6 +229,13 @@ void ESP32RMTLEDStripLightOutput::setup() {
     this->mark_failed();
     return;
   }
+  // the pixel bytes are converted to RMT items in the driver's interrupt while they are sent
+  if (rmt_translator_init(config.channel, ESP32RMTLEDStripLightOutput::translate_) != ESP_OK ||
+      rmt_translator_set_context(config.channel, this) != ESP_OK) {
+    ESP_LOGE(TAG, "Cannot initialize RMT translator!");
+    this->mark_failed();
+    return;
+  }
 #endif
 }
 
@@ -157,41 +285,21 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
   }
   delayMicroseconds(50);
 
+  // the previous frame has been sent, so its buffer can be reused; effects may keep changing buf_ while this frame
+  // is being sent
   size_t buffer_size = this->get_buffer_size_();
-
-  size_t size = 0;
-  size_t len = 0;
-  uint8_t *psrc = this->buf_;
-#if ESP_IDF_VERSION_MAJOR >= 5
-  rmt_symbol_word_t *pdest = this->rmt_buf_;
-#else
-  rmt_item32_t *pdest = this->rmt_buf_;
-#endif
-  while (size < buffer_size) {
-    uint8_t b = *psrc;
-    for (int i = 0; i < 8; i++) {
-      pdest->val = b & (1 << (7 - i)) ? this->bit1_.val : this->bit0_.val;
-      pdest++;
-      len++;
-    }
-    size++;
-    psrc++;
-  }
-
-  if (this->reset_.duration0 > 0 || this->reset_.duration1 > 0) {
-    pdest->val = this->reset_.val;
-    pdest++;
-    len++;
-  }
+  memcpy(this->tx_buf_, this->buf_, buffer_size);
 
 #if ESP_IDF_VERSION_MAJOR >= 5
   rmt_transmit_config_t config;
   memset(&config, 0, sizeof(config));
   config.loop_count = 0;
   config.flags.eot_level = 0;
-  error = rmt_transmit(this->channel_, this->encoder_, this->rmt_buf_, len * sizeof(rmt_symbol_word_t), &config);
+  error = rmt_transmit(this->channel_, this->encoder_, this->tx_buf_, buffer_size, &config);
 #else
-  error = rmt_write_items(this->channel_, this->rmt_buf_, len, false);
+  // one more byte for the reset symbol, see translate_()
+  const bool send_reset = this->reset_.duration0 > 0 || this->reset_.duration1 > 0;
+  error = rmt_write_sample(this->channel_, this->tx_buf_, send_reset ? buffer_size + 1 : buffer_size, false);
 #endif
   if (error != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX error");
@@ -201,13 +309,12 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
   this->status_clear_warning();
 }
 
-light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
-  int32_t r = 0, g = 0, b = 0;
+void ESP32RMTLEDStripLightOutput::get_channel_offsets_(uint8_t &r, uint8_t &g, uint8_t &b) const {
+  r = 0;
+  g = 1;
+  b = 2;
   switch (this->rgb_order_) {
     case ORDER_RGB:
-      r = 0;
-      g = 1;
-      b = 2;
       break;
     case ORDER_RBG:
       r = 0;
@@ -235,17 +342,72 @@ light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index
       b = 0;
       break;
   }
+  // WRGB strips send the white byte first
+  r += this->is_wrgb_;
+  g += this->is_wrgb_;
+  b += this->is_wrgb_;
+}
+
+light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
+  uint8_t r, g, b;
+  this->get_channel_offsets_(r, g, b);
   uint8_t multiplier = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
   uint8_t white = this->is_wrgb_ ? 0 : 3;
 
-  return {this->buf_ + (index * multiplier) + r + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + g + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + b + this->is_wrgb_,
+  return {this->buf_ + (index * multiplier) + r,
+          this->buf_ + (index * multiplier) + g,
+          this->buf_ + (index * multiplier) + b,
           this->is_rgbw_ || this->is_wrgb_ ? this->buf_ + (index * multiplier) + white : nullptr,
           &this->effect_data_[index],
           &this->correction_};
 }
 
+void ESP32RMTLEDStripLightOutput::set_pixels(int32_t from, const Color *colors, int32_t count) {
+  from = light::interpret_index(from, this->size());
+  uint8_t r, g, b;
+  this->get_channel_offsets_(r, g, b);
+  const bool has_white = this->is_rgbw_ || this->is_wrgb_;
+  const uint8_t multiplier = has_white ? 4 : 3;
+  const uint8_t white = this->is_wrgb_ ? 0 : 3;
+  uint8_t *pixel = this->buf_ + from * multiplier;
+  for (int32_t i = 0; i < count; i++, pixel += multiplier) {
+    pixel[r] = this->correction_.color_correct_red(colors[i].red);
+    pixel[g] = this->correction_.color_correct_green(colors[i].green);
+    pixel[b] = this->correction_.color_correct_blue(colors[i].blue);
+    if (has_white)
+      pixel[white] = this->correction_.color_correct_white(colors[i].white);
+  }
+}
+
+void ESP32RMTLEDStripLightOutput::set_pixels_rgb(int32_t from, const Color *colors, int32_t count) {
+  from = light::interpret_index(from, this->size());
+  uint8_t r, g, b;
+  this->get_channel_offsets_(r, g, b);
+  const uint8_t multiplier = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
+  uint8_t *pixel = this->buf_ + from * multiplier;
+  for (int32_t i = 0; i < count; i++, pixel += multiplier) {
+    pixel[r] = this->correction_.color_correct_red(colors[i].red);
+    pixel[g] = this->correction_.color_correct_green(colors[i].green);
+    pixel[b] = this->correction_.color_correct_blue(colors[i].blue);
+  }
+}
+
+void ESP32RMTLEDStripLightOutput::get_pixels(int32_t from, Color *colors, int32_t count) const {
+  from = light::interpret_index(from, this->size());
+  uint8_t r, g, b;
+  this->get_channel_offsets_(r, g, b);
+  const bool has_white = this->is_rgbw_ || this->is_wrgb_;
+  const uint8_t multiplier = has_white ? 4 : 3;
+  const uint8_t white = this->is_wrgb_ ? 0 : 3;
+  const uint8_t *pixel = this->buf_ + from * multiplier;
+  for (int32_t i = 0; i < count; i++, pixel += multiplier) {
+    colors[i] = Color(this->correction_.color_uncorrect_red(pixel[r]),
+                      this->correction_.color_uncorrect_green(pixel[g]),
+                      this->correction_.color_uncorrect_blue(pixel[b]),
+                      has_white ? this->correction_.color_uncorrect_white(pixel[white]) : 0);
+  }
+}
+
 void ESP32RMTLEDStripLightOutput::dump_config() {
   ESP_LOGCONFIG(TAG, "ESP32 RMT LED Strip:");
   ESP_LOGCONFIG(TAG, "  Pin: %u", this->pin_);
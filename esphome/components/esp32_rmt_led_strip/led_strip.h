@@ -71,23 +71,35 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
       this->effect_data_[i] = 0;
   }
 
+  void set_pixels(int32_t from, const Color *colors, int32_t count) override;
+  void set_pixels_rgb(int32_t from, const Color *colors, int32_t count) override;
+  void get_pixels(int32_t from, Color *colors, int32_t count) const override;
+
   void dump_config() override;
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
+  /// Offsets of the red, green and blue bytes within a pixel in buf_.
+  void get_channel_offsets_(uint8_t &r, uint8_t &g, uint8_t &b) const;
 
   size_t get_buffer_size_() const { return this->num_leds_ * (this->is_rgbw_ || this->is_wrgb_ ? 4 : 3); }
 
+#if ESP_IDF_VERSION_MAJOR < 5
+  static void translate_(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num,
+                         size_t *translated_size, size_t *item_num);
+#endif
+
   uint8_t *buf_{nullptr};
+  /// Copy of buf_ that is being transmitted, the RMT driver converts it to symbols while sending. This doubles the
+  /// pixel memory (3 or 4 bytes per LED), but lets effects keep writing buf_ without tearing the frame on the wire.
+  uint8_t *tx_buf_{nullptr};
   uint8_t *effect_data_{nullptr};
 #if ESP_IDF_VERSION_MAJOR >= 5
   rmt_channel_handle_t channel_{nullptr};
   rmt_encoder_handle_t encoder_{nullptr};
-  rmt_symbol_word_t *rmt_buf_{nullptr};
   rmt_symbol_word_t bit0_, bit1_, reset_;
   uint32_t rmt_symbols_;
 #else
-  rmt_item32_t *rmt_buf_{nullptr};
   rmt_item32_t bit0_, bit1_, reset_;
   rmt_channel_t channel_{RMT_CHANNEL_0};
 #endif
@@ -11,6 +11,8 @@ extern "C" {
 #include "esphome/core/preferences.h"
 #include "preferences.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <cstring>
 #include <vector>
 
@@ -22,6 +24,8 @@ static const char *const TAG = "esp8266.preferences";
 static bool s_prevent_write = false;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static uint32_t *s_flash_storage = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static bool s_flash_dirty = false;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Word offset in the flash sector where the next record is appended, 0 if the sector has to be rewritten.
+static uint32_t s_flash_log_end = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 static const uint32_t ESP_RTC_USER_MEM_START = 0x60001200;
 #define ESP_RTC_USER_MEM ((uint32_t *) ESP_RTC_USER_MEM_START)
@@ -34,6 +38,16 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+// The flash sector holds a log of records, each one updating a range of words of s_flash_storage. Changes are
+// appended to the log, the sector is only erased when it is full and is then rewritten with the current contents.
+// A record is a header word (marker, length and offset of the range), the words of the range and a checksum.
+static const uint32_t ESP8266_FLASH_LOG_MAGIC = 0x4C505345;  // "ESPL", sectors without it hold a plain copy
+static const uint32_t ESP8266_FLASH_LOG_SIZE = SPI_FLASH_SEC_SIZE / 4;  // in words
+static const uint32_t ESP8266_FLASH_RECORD_MARKER = 0xE5A1;
+static const uint32_t ESP8266_FLASH_EMPTY = 0xFFFFFFFF;
+// Bit per word of s_flash_storage that has changed since the last sync.
+static uint32_t s_flash_dirty_words[(ESP8266_FLASH_STORAGE_SIZE + 31) / 32] = {};  // NOLINT
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -82,8 +96,10 @@ static bool save_to_flash(size_t offset, const uint32_t *data, size_t len) {
       return false;
     uint32_t v = data[i];
     uint32_t *ptr = &s_flash_storage[j];
-    if (*ptr != v)
+    if (*ptr != v) {
       s_flash_dirty = true;
+      s_flash_dirty_words[j / 32] |= 1UL << (j % 32);
+    }
     *ptr = v;
   }
   return true;
@@ -99,6 +115,56 @@ static bool load_from_flash(size_t offset, uint32_t *data, size_t len) {
   return true;
 }
 
+static uint32_t flash_record_header(uint32_t offset, uint32_t length) {
+  return (ESP8266_FLASH_RECORD_MARKER << 16) | (length << 8) | offset;
+}
+
+// Append a record for the words [offset, offset + length) of s_flash_storage to out.
+static void append_flash_record(std::vector<uint32_t> &out, uint32_t offset, uint32_t length) {
+  uint32_t header = flash_record_header(offset, length);
+  out.push_back(header);
+  out.insert(out.end(), s_flash_storage + offset, s_flash_storage + offset + length);
+  out.push_back(calculate_crc(s_flash_storage + offset, s_flash_storage + offset + length, header));
+}
+
+// Replay the records of the log in the flash sector into s_flash_storage.
+static void load_flash_log() {
+  const uint32_t address = get_esp8266_flash_address();
+  uint32_t header;
+  std::vector<uint32_t> record;
+  uint32_t pos = 1;
+  s_flash_log_end = 0;
+  while (pos < ESP8266_FLASH_LOG_SIZE) {
+    {
+      InterruptLock lock;
+      spi_flash_read(address + pos * 4, &header, 4);
+    }
+    if (header == ESP8266_FLASH_EMPTY)
+      break;
+    uint32_t offset = header & 0xFF;
+    uint32_t length = (header >> 8) & 0xFF;
+    if ((header >> 16) != ESP8266_FLASH_RECORD_MARKER || offset + length > ESP8266_FLASH_STORAGE_SIZE ||
+        pos + length + 2 > ESP8266_FLASH_LOG_SIZE) {
+      ESP_LOGW(TAG, "Invalid preferences record at word %" PRIu32, pos);
+      return;
+    }
+    record.resize(length + 1);
+    {
+      InterruptLock lock;
+      spi_flash_read(address + (pos + 1) * 4, record.data(), record.size() * 4);
+    }
+    if (calculate_crc(record.begin(), record.end() - 1, header) != record.back()) {
+      // most likely interrupted while writing, everything before it is still valid
+      ESP_LOGW(TAG, "Preferences record at word %" PRIu32 " is corrupt", pos);
+      return;
+    }
+    memcpy(s_flash_storage + offset, record.data(), length * 4);
+    pos += length + 2;
+  }
+  s_flash_log_end = pos;
+  ESP_LOGV(TAG, "Loaded %" PRIu32 " words of preference records", pos);
+}
+
 static bool save_to_rtc(size_t offset, const uint32_t *data, size_t len) {
   for (uint32_t i = 0; i < len; i++) {
     if (!esp_rtc_user_mem_write(offset + i, data[i]))
@@ -171,7 +237,16 @@ class ESP8266Preferences : public ESPPreferences {
     s_flash_storage = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];  // NOLINT
     ESP_LOGVV(TAG, "Loading preferences from flash...");
 
+    uint32_t magic;
     {
+      InterruptLock lock;
+      spi_flash_read(get_esp8266_flash_address(), &magic, 4);
+    }
+    if (magic == ESP8266_FLASH_LOG_MAGIC) {
+      std::fill(s_flash_storage, s_flash_storage + ESP8266_FLASH_STORAGE_SIZE, ESP8266_FLASH_EMPTY);
+      load_flash_log();
+    } else {
+      // plain copy written by older versions, converted to a log on the first sync
       InterruptLock lock;
       spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
     }
@@ -235,24 +310,53 @@ class ESP8266Preferences : public ESPPreferences {
     if (s_prevent_write)
       return false;
 
-    ESP_LOGD(TAG, "Saving preferences to flash...");
-    SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
-    {
+    // one record for each run of changed words
+    std::vector<uint32_t> records;
+    uint32_t start = 0;
+    while (start < ESP8266_FLASH_STORAGE_SIZE) {
+      if (!(s_flash_dirty_words[start / 32] & (1UL << (start % 32)))) {
+        start++;
+        continue;
+      }
+      uint32_t end = start + 1;
+      while (end < ESP8266_FLASH_STORAGE_SIZE && (s_flash_dirty_words[end / 32] & (1UL << (end % 32))))
+        end++;
+      append_flash_record(records, start, end - start);
+      start = end;
+    }
+
+    SpiFlashOpResult erase_res = SPI_FLASH_RESULT_OK, write_res = SPI_FLASH_RESULT_OK;
+    uint32_t write_pos = s_flash_log_end;
+    if (write_pos == 0 || write_pos + records.size() > ESP8266_FLASH_LOG_SIZE) {
+      // log is full, start over with a single record of all words
+      ESP_LOGD(TAG, "Saving preferences to flash...");
+      records.clear();
+      records.push_back(ESP8266_FLASH_LOG_MAGIC);
+      append_flash_record(records, 0, ESP8266_FLASH_STORAGE_SIZE);
+      write_pos = 0;
       InterruptLock lock;
       erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
       if (erase_res == SPI_FLASH_RESULT_OK) {
-        write_res = spi_flash_write(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+        write_res = spi_flash_write(get_esp8266_flash_address(), records.data(), records.size() * 4);
       }
+    } else {
+      ESP_LOGD(TAG, "Appending %zu words of preferences to flash...", records.size());
+      InterruptLock lock;
+      write_res = spi_flash_write(get_esp8266_flash_address() + write_pos * 4, records.data(), records.size() * 4);
     }
     if (erase_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
+      s_flash_log_end = 0;
       return false;
     }
     if (write_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGE(TAG, "Write ESP8266 flash failed!");
+      s_flash_log_end = 0;
       return false;
     }
 
+    s_flash_log_end = write_pos + records.size();
+    memset(s_flash_dirty_words, 0, sizeof(s_flash_dirty_words));
     s_flash_dirty = false;
     return true;
   }
@@ -264,6 +368,7 @@ class ESP8266Preferences : public ESPPreferences {
       InterruptLock lock;
       erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
     }
+    s_flash_log_end = 0;
     if (erase_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
       return false;
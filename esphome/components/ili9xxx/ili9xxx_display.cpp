@@ -57,10 +57,7 @@ void ILI9XXXDisplay::setup() {
 
   this->set_madctl();
   this->command(this->pre_invertcolors_ ? ILI9XXX_INVON : ILI9XXX_INVOFF);
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  this->reset_dirty_tiles_(false);
 }
 
 void ILI9XXXDisplay::alloc_buffer_() {
@@ -71,6 +68,23 @@ void ILI9XXXDisplay::alloc_buffer_() {
   }
   if (this->buffer_ == nullptr) {
     this->mark_failed();
+    return;
+  }
+  RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+  this->scratch_buffer_ = allocator.allocate(ILI9XXX_SCRATCH_BUFFER_SIZE * 2);
+  if (this->scratch_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate transfer buffers!");
+    this->mark_failed();
+    return;
+  }
+  if (this->buffer_color_mode_ != BITS_16) {
+    this->color_table_.resize(256);
+    for (size_t i = 0; i != 256; i++) {
+      Color color = this->buffer_color_mode_ == BITS_8_INDEXED
+                        ? display::ColorUtil::index8_to_color_palette888(i, this->palette_)
+                        : display::ColorUtil::rgb332_to_color(i);
+      this->color_table_[i] = display::ColorUtil::color_to_565(color);
+    }
   }
 }
 
@@ -129,10 +143,7 @@ void ILI9XXXDisplay::fill(Color color) {
   if (!this->check_buffer_())
     return;
   uint16_t new_color = 0;
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->reset_dirty_tiles_(true);
   switch (this->buffer_color_mode_) {
     case BITS_8_INDEXED:
       new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
@@ -191,17 +202,8 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
     this->buffer_[pos] = new_color;
     updated = true;
   }
-  if (updated) {
-    // low and high watermark may speed up drawing from buffer
-    if (x < this->x_low_)
-      this->x_low_ = x;
-    if (y < this->y_low_)
-      this->y_low_ = y;
-    if (x > this->x_high_)
-      this->x_high_ = x;
-    if (y > this->y_high_)
-      this->y_high_ = y;
-  }
+  if (updated)
+    this->dirty_tiles_[y >> this->tile_shift_] |= 1UL << (x >> this->tile_shift_);
 }
 
 void ILI9XXXDisplay::update() {
@@ -218,86 +220,146 @@ void ILI9XXXDisplay::update() {
   this->display_();
 }
 
+// Resize the tile map to the current dimensions and mark all tiles as either dirty or clean.
+void ILI9XXXDisplay::reset_dirty_tiles_(bool dirty) {
+  this->tile_shift_ = 5;
+  while (((this->width_ - 1) >> this->tile_shift_) >= 32)
+    this->tile_shift_++;
+  const size_t cols = ((this->width_ - 1) >> this->tile_shift_) + 1;
+  const size_t rows = ((this->height_ - 1) >> this->tile_shift_) + 1;
+  const uint32_t all = cols == 32 ? UINT32_MAX : (1UL << cols) - 1;
+  this->dirty_tiles_.assign(rows, dirty ? all : 0);
+}
+
 void ILI9XXXDisplay::display_() {
-  // check if something was displayed
-  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
-    return;
+  // Send each run of dirty tiles in a row of tiles as one rectangle, extended downwards for as long as the next
+  // rows have exactly the same run. Two small changes far apart are sent as two small rectangles.
+  struct TileRun {
+    uint8_t first_col;
+    uint8_t last_col;
+    uint16_t first_row;
+  };
+  TileRun runs[2][16];  // a row of 32 tiles has at most 16 runs
+  size_t num_runs[2] = {0, 0};
+  size_t cur = 0;
+  const size_t rows = this->dirty_tiles_.size();
+  for (size_t row = 0; row <= rows; row++) {
+    TileRun *prev_runs = runs[cur];
+    const size_t num_prev = num_runs[cur];
+    cur ^= 1;
+    num_runs[cur] = 0;
+    uint32_t bits = row != rows ? this->dirty_tiles_[row] : 0;
+    while (bits != 0) {
+      const uint8_t first = __builtin_ctz(bits);
+      const uint32_t from_first = bits >> first;
+      const uint8_t len = ~from_first == 0 ? 32 - first : __builtin_ctz(~from_first);
+      bits = len == 32 ? 0 : bits & ~(((1UL << len) - 1) << first);
+      TileRun run{first, static_cast<uint8_t>(first + len - 1), static_cast<uint16_t>(row)};
+      for (size_t i = 0; i != num_prev; i++) {
+        if (prev_runs[i].first_col == run.first_col && prev_runs[i].last_col == run.last_col) {
+          run.first_row = prev_runs[i].first_row;
+          // mark as continued
+          prev_runs[i].last_col = 0;
+          prev_runs[i].first_col = 1;
+          break;
+        }
+      }
+      runs[cur][num_runs[cur]++] = run;
+    }
+    // runs that didn't continue in this row are complete
+    for (size_t i = 0; i != num_prev; i++) {
+      if (prev_runs[i].first_col <= prev_runs[i].last_col)
+        this->write_tiles_(prev_runs[i].first_col, prev_runs[i].last_col, prev_runs[i].first_row, row - 1);
+    }
   }
+  this->reset_dirty_tiles_(false);
+}
+
+void ILI9XXXDisplay::write_tiles_(uint8_t first_col, uint8_t last_col, uint16_t first_row, uint16_t last_row) {
+  const uint8_t shift = this->tile_shift_;
+  this->write_rect_(first_col << shift, first_row << shift, std::min((last_col + 1) << shift, (int) this->width_) - 1,
+                    std::min((last_row + 1) << shift, (int) this->height_) - 1);
+}
 
-  // we will only update the changed rows to the display
-  size_t const w = this->x_high_ - this->x_low_ + 1;
-  size_t const h = this->y_high_ - this->y_low_ + 1;
+void ILI9XXXDisplay::write_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
+  size_t const w = x2 - x1 + 1;
+  size_t const h = y2 - y1 + 1;
 
   size_t mhz = this->data_rate_ / 1000000;
   // estimate time for a single write
   size_t sw_time = this->width_ * h * 16 / mhz + this->width_ * h * 2 / SPI_MAX_BLOCK_SIZE * SPI_SETUP_US * 2;
   // estimate time for multiple writes
-  size_t mw_time = (w * h * 16) / mhz + w * h * 2 / ILI9XXX_TRANSFER_BUFFER_SIZE * SPI_SETUP_US;
+  size_t mw_time = (w * h * 16) / mhz + w * h * 2 / ILI9XXX_SCRATCH_BUFFER_SIZE * SPI_SETUP_US;
   ESP_LOGV(TAG,
-           "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, "
+           "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%zu, "
            "height:%zu, mode=%d, 18bit=%d, sw_time=%zuus, mw_time=%zuus)",
-           this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, this->buffer_color_mode_,
-           this->is_18bitdisplay_, sw_time, mw_time);
+           x1, y1, x2, y2, w, h, this->buffer_color_mode_, this->is_18bitdisplay_, sw_time, mw_time);
   auto now = millis();
   if (this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_ && sw_time < mw_time) {
     // 16 bit mode maps directly to display format
     ESP_LOGV(TAG, "Doing single write of %zu bytes", this->width_ * h * 2);
-    set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
-    this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+    this->set_addr_window_(0, y1, this->width_ - 1, y2);
+    this->write_array(this->buffer_ + y1 * this->width_ * 2, h * this->width_ * 2);
   } else {
+    // convert rows into one scratch buffer while the other one is being sent
     ESP_LOGV(TAG, "Doing multiple write");
-    uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
-    size_t rem = h * w;  // remaining number of pixels to write
-    set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
-    size_t idx = 0;    // index into transfer_buffer
-    size_t pixel = 0;  // pixel number offset
-    size_t pos = this->y_low_ * this->width_ + this->x_low_;
-    while (rem-- != 0) {
-      uint16_t color_val;
-      switch (this->buffer_color_mode_) {
-        case BITS_8:
-          color_val = display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(this->buffer_[pos++]));
-          break;
-        case BITS_8_INDEXED:
-          color_val = display::ColorUtil::color_to_565(
-              display::ColorUtil::index8_to_color_palette888(this->buffer_[pos++], this->palette_));
-          break;
-        default:  // case BITS_16:
-          color_val = (this->buffer_[pos * 2] << 8) + this->buffer_[pos * 2 + 1];
-          pos++;
-          break;
-      }
-      if (this->is_18bitdisplay_) {
-        transfer_buffer[idx++] = (uint8_t) ((color_val & 0xF800) >> 8);  // Blue
-        transfer_buffer[idx++] = (uint8_t) ((color_val & 0x7E0) >> 3);   // Green
-        transfer_buffer[idx++] = (uint8_t) (color_val << 3);             // Red
-      } else {
-        put16_be(transfer_buffer + idx, color_val);
-        idx += 2;
-      }
-      if (idx == sizeof(transfer_buffer)) {
-        this->write_array(transfer_buffer, idx);
-        idx = 0;
-        App.feed_wdt();
-      }
-      // end of line? Skip to the next.
-      if (++pixel == w) {
-        pixel = 0;
-        pos += this->width_ - w;
+    const size_t bytes_per_pixel = this->is_18bitdisplay_ ? 3 : 2;
+    uint8_t *scratch = this->scratch_buffer_;
+    uint8_t *out = scratch;
+    this->set_addr_window_(x1, y1, x2, y2);
+    size_t pos = y1 * this->width_ + x1;
+    for (size_t row = 0; row != h; row++, pos += this->width_) {
+      size_t done = 0;
+      while (done != w) {
+        const size_t space = (scratch + ILI9XXX_SCRATCH_BUFFER_SIZE - out) / bytes_per_pixel;
+        const size_t count = std::min(w - done, space);
+        out = this->convert_pixels_(pos + done, count, out);
+        done += count;
+        if (count == space) {
+          this->write_array_async(scratch, out - scratch);
+          scratch = scratch == this->scratch_buffer_ ? scratch + ILI9XXX_SCRATCH_BUFFER_SIZE : this->scratch_buffer_;
+          out = scratch;
+          App.feed_wdt();
+        }
       }
     }
     // flush any balance.
-    if (idx != 0) {
-      this->write_array(transfer_buffer, idx);
-    }
+    if (out != scratch)
+      this->write_array_async(scratch, out - scratch);
   }
   this->end_data_();
   ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+}
+
+// Convert count pixels of the buffer starting at pixel pos into display format, return the end of the output.
+uint8_t *ILI9XXXDisplay::convert_pixels_(size_t pos, size_t count, uint8_t *out) {
+  if (this->buffer_color_mode_ == BITS_16) {
+    const uint8_t *src = this->buffer_ + pos * 2;
+    if (!this->is_18bitdisplay_) {
+      memcpy(out, src, count * 2);
+      return out + count * 2;
+    }
+    for (size_t i = 0; i != count; i++, src += 2) {
+      *out++ = src[0] & 0xF8;                           // Blue
+      *out++ = ((src[0] << 5) | (src[1] >> 3)) & 0xFC;  // Green
+      *out++ = src[1] << 3;                             // Red
+    }
+    return out;
+  }
+  const uint8_t *src = this->buffer_ + pos;
+  const uint16_t *table = this->color_table_.data();
+  for (size_t i = 0; i != count; i++) {
+    const uint16_t color_val = table[src[i]];
+    if (this->is_18bitdisplay_) {
+      *out++ = (uint8_t) ((color_val & 0xF800) >> 8);  // Blue
+      *out++ = (uint8_t) ((color_val & 0x7E0) >> 3);   // Green
+      *out++ = (uint8_t) (color_val << 3);             // Red
+    } else {
+      put16_be(out, color_val);
+      out += 2;
+    }
+  }
+  return out;
 }
 
 // note that this bypasses the buffer and writes directly to the display.
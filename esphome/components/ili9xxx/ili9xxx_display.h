@@ -10,6 +10,8 @@ namespace ili9xxx {
 
 static const char *const TAG = "ili9xxx";
 const size_t ILI9XXX_TRANSFER_BUFFER_SIZE = 126;  // ensure this is divisible by 6
+// size of each of the two buffers converted pixels are sent from, ensure this is divisible by 6
+const size_t ILI9XXX_SCRATCH_BUFFER_SIZE = 1536;
 
 enum ILI9XXXColorMode {
   BITS_8 = 0x08,
@@ -110,6 +112,10 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
 
   virtual void set_madctl();
   void display_();
+  void reset_dirty_tiles_(bool dirty);
+  void write_tiles_(uint8_t first_col, uint8_t last_col, uint16_t first_row, uint16_t last_row);
+  void write_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+  uint8_t *convert_pixels_(size_t pos, size_t count, uint8_t *out);
   void init_lcd_(const uint8_t *addr);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t x2, uint16_t y2);
   void reset_();
@@ -120,10 +126,14 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   int16_t height_{0};  ///< Display height as modified by current rotation
   int16_t offset_x_{0};
   int16_t offset_y_{0};
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
+  /// One bit per tile for each row of tiles, set when a pixel in the tile has changed since the last update.
+  std::vector<uint32_t> dirty_tiles_;
+  /// Tiles are (1 << tile_shift_) pixels square, large enough for a row of tiles to fit in 32 bits.
+  uint8_t tile_shift_{5};
+  /// Two buffers of ILI9XXX_SCRATCH_BUFFER_SIZE bytes in internal, DMA capable memory.
+  uint8_t *scratch_buffer_{nullptr};
+  /// RGB565 value of each 8 bit color when the buffer is not in 16 bit mode.
+  std::vector<uint16_t> color_table_;
   const uint8_t *palette_{};
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
@@ -0,0 +1,188 @@
+#include "json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+void JsonWriter::separator_() {
+  if (this->after_key_) {
+    this->after_key_ = false;
+    return;
+  }
+  if (this->depth_ == 0 || this->depth_ > 32)
+    return;
+  const uint32_t bit = 1UL << (this->depth_ - 1);
+  if (this->empty_ & bit) {
+    this->empty_ &= ~bit;
+  } else {
+    this->raw_(",", 1);
+  }
+}
+
+void JsonWriter::open_(char c) {
+  this->separator_();
+  this->raw_(&c, 1);
+  this->depth_++;
+  if (this->depth_ <= 32)
+    this->empty_ |= 1UL << (this->depth_ - 1);
+}
+
+void JsonWriter::close_(char c) {
+  this->raw_(&c, 1);
+  if (this->depth_ > 0)
+    this->depth_--;
+}
+
+void JsonWriter::begin_object() { this->open_('{'); }
+void JsonWriter::begin_object(const char *key) {
+  this->key(key);
+  this->open_('{');
+}
+void JsonWriter::end_object() { this->close_('}'); }
+void JsonWriter::begin_array() { this->open_('['); }
+void JsonWriter::begin_array(const char *key) {
+  this->key(key);
+  this->open_('[');
+}
+void JsonWriter::end_array() { this->close_(']'); }
+
+void JsonWriter::key(const char *key) {
+  this->string_(key, strlen(key));
+  this->raw_(":", 1);
+  this->after_key_ = true;
+}
+
+void JsonWriter::value(const char *value) {
+  if (value == nullptr) {
+    this->value(nullptr);
+    return;
+  }
+  this->string_(value, strlen(value));
+}
+void JsonWriter::value(bool value) {
+  this->separator_();
+  if (value) {
+    this->raw_("true", 4);
+  } else {
+    this->raw_("false", 5);
+  }
+}
+void JsonWriter::value(float value) {
+  if (!std::isfinite(value)) {
+    this->value(nullptr);
+    return;
+  }
+  this->separator_();
+  char buf[24];
+  int len = snprintf(buf, sizeof(buf), "%.7g", value);
+  this->raw_(buf, len);
+}
+void JsonWriter::value(double value) {
+  if (!std::isfinite(value)) {
+    this->value(nullptr);
+    return;
+  }
+  this->separator_();
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "%.15g", value);
+  this->raw_(buf, len);
+}
+void JsonWriter::value(std::nullptr_t /*value*/) {
+  this->separator_();
+  this->raw_("null", 4);
+}
+
+static char *format_uint(char *end, uint64_t value) {
+  char *p = end;
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  return p;
+}
+
+void JsonWriter::int_(int64_t value) {
+  this->separator_();
+  char buf[21];
+  char *end = buf + sizeof(buf);
+  char *p = format_uint(end, value < 0 ? -static_cast<uint64_t>(value) : value);
+  if (value < 0)
+    *--p = '-';
+  this->raw_(p, end - p);
+}
+
+void JsonWriter::uint_(uint64_t value) {
+  this->separator_();
+  char buf[20];
+  char *end = buf + sizeof(buf);
+  char *p = format_uint(end, value);
+  this->raw_(p, end - p);
+}
+
+void JsonWriter::string_(const char *str, size_t len) {
+  static const char *const HEX_CHARS = "0123456789abcdef";
+  this->separator_();
+  this->raw_("\"", 1);
+  // write runs of characters that need no escaping in one go
+  size_t start = 0;
+  for (size_t i = 0; i < len; i++) {
+    const uint8_t c = str[i];
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    if (i > start)
+      this->raw_(str + start, i - start);
+    start = i + 1;
+    switch (c) {
+      case '"':
+        this->raw_("\\\"", 2);
+        break;
+      case '\\':
+        this->raw_("\\\\", 2);
+        break;
+      case '\b':
+        this->raw_("\\b", 2);
+        break;
+      case '\f':
+        this->raw_("\\f", 2);
+        break;
+      case '\n':
+        this->raw_("\\n", 2);
+        break;
+      case '\r':
+        this->raw_("\\r", 2);
+        break;
+      case '\t':
+        this->raw_("\\t", 2);
+        break;
+      default: {
+        const char escaped[6] = {'\\', 'u', '0', '0', HEX_CHARS[c >> 4], HEX_CHARS[c & 0xF]};
+        this->raw_(escaped, sizeof(escaped));
+        break;
+      }
+    }
+  }
+  if (len > start)
+    this->raw_(str + start, len - start);
+  this->raw_("\"", 1);
+}
+
+std::string write_json(const json_write_t &f) {
+  std::string output;
+  write_json(output, f);
+  return output;
+}
+
+void write_json(std::string &output, const json_write_t &f) {
+  output.clear();
+  StringJsonSink sink(output);
+  JsonWriter writer(sink);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+}
+
+}  // namespace json
+}  // namespace esphome
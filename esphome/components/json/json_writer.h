@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+namespace esphome {
+namespace json {
+
+/// Destination of the output of a JsonWriter.
+class JsonSink {
+ public:
+  virtual void write(const char *data, size_t len) = 0;
+};
+
+/// JsonSink that appends to a std::string.
+class StringJsonSink : public JsonSink {
+ public:
+  explicit StringJsonSink(std::string &output) : output_(output) {}
+  void write(const char *data, size_t len) override { this->output_.append(data, len); }
+
+ protected:
+  std::string &output_;
+};
+
+/** Serialize JSON straight into a JsonSink, without building a document first.
+ *
+ * Objects and arrays are opened and closed explicitly and the writer only takes care of separators and escaping,
+ * so the caller must write every key of an object at most once and finish each nested object before writing the
+ * next member of its parent. Non-finite numbers are written as null, like ArduinoJson does.
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(JsonSink &sink) : sink_(sink) {}
+
+  void begin_object();
+  void begin_object(const char *key);
+  void end_object();
+  void begin_array();
+  void begin_array(const char *key);
+  void end_array();
+
+  /// Write the key of the next member, followed by exactly one value.
+  void key(const char *key);
+
+  void value(const char *value);
+  void value(const std::string &value) { this->string_(value.data(), value.size()); }
+  void value(bool value);
+  void value(float value);
+  void value(double value);
+  void value(std::nullptr_t value);
+  template<typename T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+  void value(T value) {
+    this->int_(value);
+  }
+  template<typename T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                                                   !std::is_same<T, bool>::value,
+                                               int>::type = 0>
+  void value(T value) {
+    this->uint_(value);
+  }
+
+  /// Write a key/value member of the current object.
+  template<typename T> void member(const char *key, T &&value) {
+    this->key(key);
+    this->value(std::forward<T>(value));
+  }
+
+ protected:
+  void separator_();
+  void open_(char c);
+  void close_(char c);
+  void string_(const char *str, size_t len);
+  void int_(int64_t value);
+  void uint_(uint64_t value);
+  void raw_(const char *data, size_t len) { this->sink_.write(data, len); }
+
+  JsonSink &sink_;
+  /// Bit n is set while the container at depth n has no elements yet.
+  uint32_t empty_{0};
+  uint8_t depth_{0};
+  /// The next value completes a member, no separator needed.
+  bool after_key_{false};
+};
+
+/// Callback function typedef for writing JSON with a JsonWriter.
+using json_write_t = std::function<void(JsonWriter &)>;
+
+/// Write a JSON object with the provided function into a string.
+std::string write_json(const json_write_t &f);
+/// Write a JSON object with the provided function into \p output, reusing its capacity.
+void write_json(std::string &output, const json_write_t &f);
+
+}  // namespace json
+}  // namespace esphome
@@ -1,6 +1,8 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace light {
 
@@ -27,6 +29,24 @@ std::unique_ptr<LightTransformer> AddressableLight::create_default_transition()
   return make_unique<AddressableLightTransformer>(*this);
 }
 
+void AddressableLight::set_pixels(int32_t from, const Color *colors, int32_t count) {
+  from = interpret_index(from, this->size());
+  for (int32_t i = 0; i < count; i++)
+    this->get_view_internal(from + i).set(colors[i]);
+}
+
+void AddressableLight::set_pixels_rgb(int32_t from, const Color *colors, int32_t count) {
+  from = interpret_index(from, this->size());
+  for (int32_t i = 0; i < count; i++)
+    this->get_view_internal(from + i).set_rgb(colors[i].red, colors[i].green, colors[i].blue);
+}
+
+void AddressableLight::get_pixels(int32_t from, Color *colors, int32_t count) const {
+  from = interpret_index(from, this->size());
+  for (int32_t i = 0; i < count; i++)
+    colors[i] = this->get_view_internal(from + i).get();
+}
+
 Color color_from_light_color_values(LightColorValues val) {
   auto r = to_uint8_scale(val.get_color_brightness() * val.get_red());
   auto g = to_uint8_scale(val.get_color_brightness() * val.get_green());
@@ -99,8 +119,15 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
     uint8_t inv_alpha8 = 255 - alpha8;
     Color add = this->target_color_ * alpha8;
 
-    for (auto led : this->light_)
-      led.set(add + led.get() * inv_alpha8);
+    Color colors[ADDRESSABLE_LIGHT_CHUNK_SIZE];
+    const int32_t size = this->light_.size();
+    for (int32_t from = 0; from < size; from += ADDRESSABLE_LIGHT_CHUNK_SIZE) {
+      const int32_t count = std::min(size - from, ADDRESSABLE_LIGHT_CHUNK_SIZE);
+      this->light_.get_pixels(from, colors, count);
+      for (int32_t i = 0; i < count; i++)
+        colors[i] = add + colors[i] * inv_alpha8;
+      this->light_.set_pixels(from, colors, count);
+    }
   }
 
   this->last_transition_progress_ = smoothed_progress;
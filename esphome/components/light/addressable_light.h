@@ -19,6 +19,9 @@ namespace light {
 
 using ESPColor ESPDEPRECATED("esphome::light::ESPColor is deprecated, use esphome::Color instead.", "v1.21") = Color;
 
+/// Number of pixels that effects and transitions process at once through the bulk pixel API.
+static const int32_t ADDRESSABLE_LIGHT_CHUNK_SIZE = 32;
+
 /// Convert the color information from a `LightColorValues` object to a `Color` object (does not apply brightness).
 Color color_from_light_color_values(LightColorValues val);
 
@@ -40,6 +43,13 @@ class AddressableLight : public LightOutput, public Component {
     return ESPRangeView(this, from, to);
   }
   ESPRangeView all() { return ESPRangeView(this, 0, this->size()); }
+  /// Set the \p count pixels starting at \p from to \p colors, with color correction like ESPColorView::set().
+  virtual void set_pixels(int32_t from, const Color *colors, int32_t count);
+  /// Like set_pixels(), but only sets red, green and blue and leaves the white channel alone.
+  virtual void set_pixels_rgb(int32_t from, const Color *colors, int32_t count);
+  /// Read the \p count pixels starting at \p from into \p colors, with color correction reverted like
+  /// ESPColorView::get().
+  virtual void get_pixels(int32_t from, Color *colors, int32_t count) const;
   ESPRangeIterator begin() { return this->all().begin(); }
   ESPRangeIterator end() { return this->all().end(); }
   void shift_left(int32_t amnt) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -81,10 +82,17 @@ class AddressableRainbowLightEffect : public AddressableLightEffect {
     hsv.saturation = 240;
     uint16_t hue = (millis() * this->speed_) % 0xFFFF;
     const uint16_t add = 0xFFFF / this->width_;
-    for (auto var : it) {
-      hsv.hue = hue >> 8;
-      var = hsv;
-      hue += add;
+    Color colors[ADDRESSABLE_LIGHT_CHUNK_SIZE];
+    const int32_t size = it.size();
+    for (int32_t from = 0; from < size; from += ADDRESSABLE_LIGHT_CHUNK_SIZE) {
+      const int32_t count = std::min(size - from, ADDRESSABLE_LIGHT_CHUNK_SIZE);
+      for (int32_t i = 0; i < count; i++) {
+        hsv.hue = hue >> 8;
+        colors[i] = hsv.to_rgb();
+        hue += add;
+      }
+      // like assigning the HSV color to each pixel, the white channel is kept
+      it.set_pixels_rgb(from, colors, count);
     }
     it.schedule_show();
   }
@@ -205,11 +213,12 @@ class AddressableTwinkleEffect : public AddressableLightEffect {
       this->last_progress_ += pos_add32 * this->progress_interval_;
     }
     for (auto view : addressable) {
-      if (view.get_effect_data() != 0) {
-        const uint8_t sine = half_sin8(view.get_effect_data());
+      const uint8_t pos = view.get_effect_data();
+      if (pos != 0) {
+        const uint8_t sine = half_sin8(pos);
         view = current_color * sine;
-        const uint8_t new_pos = view.get_effect_data() + pos_add;
-        if (new_pos < view.get_effect_data()) {
+        const uint8_t new_pos = pos + pos_add;
+        if (new_pos < pos) {
           view.set_effect_data(0);
         } else {
           view.set_effect_data(new_pos);
@@ -247,9 +256,10 @@ class AddressableRandomTwinkleEffect : public AddressableLightEffect {
     }
     uint8_t subsine = ((8 * (now - this->last_progress_)) / this->progress_interval_) & 0b111;
     for (auto view : it) {
-      if (view.get_effect_data() != 0) {
-        const uint8_t x = (view.get_effect_data() >> 3) & 0b11111;
-        const uint8_t color = view.get_effect_data() & 0b111;
+      const uint8_t data = view.get_effect_data();
+      if (data != 0) {
+        const uint8_t x = (data >> 3) & 0b11111;
+        const uint8_t color = data & 0b111;
         const uint16_t sine = half_sin8((x << 3) | subsine);
         if (color == 0) {
           view = current_color * sine;
@@ -298,18 +308,32 @@ class AddressableFireworksEffect : public AddressableLightEffect {
     this->last_update_ = now;
     // "invert" the fade out parameter so that higher values make fade out faster
     const uint8_t fade_out_mult = 255u - this->fade_out_rate_;
-    for (auto view : it) {
-      Color target = view.get() * fade_out_mult;
-      if (target.r < 64)
-        target *= 170;
-      view = target;
-    }
-    int last = it.size() - 1;
-    it[0].set(it[0].get() + (it[1].get() * 128));
-    for (int i = 1; i < last; i++) {
-      it[i] = (it[i - 1].get() * 64) + it[i].get() + (it[i + 1].get() * 64);
+    const int32_t size = it.size();
+    if (size > 0) {
+      // Fade out and blur each pixel with its neighbours in a single pass. The left neighbour has already been
+      // blurred, the right one is read one pixel ahead of the chunk and only faded.
+      Color colors[ADDRESSABLE_LIGHT_CHUNK_SIZE + 1];
+      Color prev;
+      for (int32_t from = 0; from < size; from += ADDRESSABLE_LIGHT_CHUNK_SIZE) {
+        const int32_t count = std::min(size - from, ADDRESSABLE_LIGHT_CHUNK_SIZE);
+        const int32_t read = std::min(size - from, ADDRESSABLE_LIGHT_CHUNK_SIZE + 1);
+        it.get_pixels(from, colors, read);
+        for (int32_t i = 0; i < read; i++)
+          colors[i] = this->fade_out_(colors[i], fade_out_mult);
+        for (int32_t i = 0; i < count; i++) {
+          const int32_t index = from + i;
+          if (index == 0 && size > 1) {
+            colors[i] = colors[i] + (colors[i + 1] * 128);
+          } else if (index == size - 1) {
+            colors[i] = colors[i] + (prev * 128);
+          } else {
+            colors[i] = (prev * 64) + colors[i] + (colors[i + 1] * 64);
+          }
+          prev = colors[i];
+        }
+        it.set_pixels(from, colors, count);
+      }
     }
-    it[last] = it[last].get() + (it[last - 1].get() * 128);
     if (random_float() < this->spark_probability_) {
       const size_t pos = random_uint32() % it.size();
       if (this->use_random_color_) {
@@ -326,6 +350,13 @@ class AddressableFireworksEffect : public AddressableLightEffect {
   void set_fade_out_rate(uint8_t fade_out_rate) { this->fade_out_rate_ = fade_out_rate; }
 
  protected:
+  static Color fade_out_(Color color, uint8_t fade_out_mult) {
+    color *= fade_out_mult;
+    if (color.r < 64)
+      color *= 170;
+    return color;
+  }
+
   uint8_t fade_out_rate_{};
   uint32_t update_interval_{};
   uint32_t last_update_{0};
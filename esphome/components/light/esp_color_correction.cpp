@@ -11,6 +11,7 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
     auto corrected = to_uint8_scale(gamma_correct(i / 255.0f, gamma));
     this->gamma_table_[i] = corrected;
   }
+  this->calculate_brightness_table_();
   if (gamma == 0.0f) {
     for (uint16_t i = 0; i < 256; i++)
       this->gamma_reverse_table_[i] = i;
@@ -23,5 +24,10 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   }
 }
 
+void ESPColorCorrection::calculate_brightness_table_() {
+  for (uint16_t i = 0; i < 256; i++)
+    this->brightness_table_[i] = this->gamma_table_[esp_scale8(i, this->local_brightness_)];
+}
+
 }  // namespace light
 }  // namespace esphome
@@ -9,7 +9,12 @@ class ESPColorCorrection {
  public:
   ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
   void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  void set_local_brightness(uint8_t local_brightness) {
+    if (local_brightness == this->local_brightness_)
+      return;
+    this->local_brightness_ = local_brightness;
+    this->calculate_brightness_table_();
+  }
   void calculate_gamma_table(float gamma);
   inline Color color_correct(Color color) const ESPHOME_ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
@@ -17,20 +22,16 @@ class ESPColorCorrection {
                  this->color_correct_blue(color.blue), this->color_correct_white(color.white));
   }
   inline uint8_t color_correct_red(uint8_t red) const ESPHOME_ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(red, this->max_brightness_.red), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(red, this->max_brightness_.red)];
   }
   inline uint8_t color_correct_green(uint8_t green) const ESPHOME_ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(green, this->max_brightness_.green), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(green, this->max_brightness_.green)];
   }
   inline uint8_t color_correct_blue(uint8_t blue) const ESPHOME_ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(blue, this->max_brightness_.blue), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(blue, this->max_brightness_.blue)];
   }
   inline uint8_t color_correct_white(uint8_t white) const ESPHOME_ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(white, this->max_brightness_.white), this->local_brightness_);
-    return this->gamma_table_[res];
+    return this->brightness_table_[esp_scale8(white, this->max_brightness_.white)];
   }
   inline Color color_uncorrect(Color color) const ESPHOME_ALWAYS_INLINE {
     // uncorrected = corrected^(1/gamma) / (max_brightness * local_brightness)
@@ -67,7 +68,11 @@ class ESPColorCorrection {
   }
 
  protected:
+  void calculate_brightness_table_();
+
   uint8_t gamma_table_[256];
+  /// gamma_table_ with the local brightness applied, so correcting a channel takes a single lookup.
+  uint8_t brightness_table_[256];
   uint8_t gamma_reverse_table_[256];
   Color max_brightness_;
   uint8_t local_brightness_{255};
@@ -35,7 +35,7 @@ class ESPColorSettable {
   }
 };
 
-class ESPColorView : public ESPColorSettable {
+class ESPColorView final : public ESPColorSettable {
  public:
   ESPColorView(uint8_t *red, uint8_t *green, uint8_t *blue, uint8_t *white, uint8_t *effect_data,
                const ESPColorCorrection *color_correction)
@@ -53,7 +53,13 @@ class ESPColorView : public ESPColorSettable {
     this->set_hsv(rhs);
     return *this;
   }
-  void set(const Color &color) override { this->set_rgbw(color.r, color.g, color.b, color.w); }
+  void set(const Color &color) override {
+    *this->red_ = this->color_correction_->color_correct_red(color.red);
+    *this->green_ = this->color_correction_->color_correct_green(color.green);
+    *this->blue_ = this->color_correction_->color_correct_blue(color.blue);
+    if (this->white_ != nullptr)
+      *this->white_ = this->color_correction_->color_correct_white(color.white);
+  }
   void set_red(uint8_t red) override { *this->red_ = this->color_correction_->color_correct_red(red); }
   void set_green(uint8_t green) override { *this->green_ = this->color_correction_->color_correct_green(green); }
   void set_blue(uint8_t blue) override { *this->blue_ = this->color_correction_->color_correct_blue(blue); }
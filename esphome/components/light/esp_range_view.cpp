@@ -1,6 +1,8 @@
 #include "esp_range_view.h"
 #include "addressable_light.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace light {
 
@@ -65,25 +67,26 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   if (rhs.size() != this->size())
     return *this;
 
-  if (this->parent_ != rhs.parent_) {
-    for (int32_t i = 0; i < this->size(); i++)
-      (*this)[i].set(rhs[i].get());
-    return *this;
-  }
-
   // If both equal, already done
-  if (rhs.begin_ == this->begin_)
+  if (this->parent_ == rhs.parent_ && rhs.begin_ == this->begin_)
     return *this;
 
-  if (rhs.begin_ > this->begin_) {
+  // When the ranges overlap, copy in the direction that reads every pixel before it is overwritten
+  Color colors[ADDRESSABLE_LIGHT_CHUNK_SIZE];
+  const int32_t size = this->size();
+  if (this->parent_ != rhs.parent_ || rhs.begin_ > this->begin_) {
     // Copy from left
-    for (int32_t i = 0; i < this->size(); i++) {
-      (*this)[i].set(rhs[i].get());
+    for (int32_t i = 0; i < size; i += ADDRESSABLE_LIGHT_CHUNK_SIZE) {
+      const int32_t count = std::min(size - i, ADDRESSABLE_LIGHT_CHUNK_SIZE);
+      rhs.parent_->get_pixels(rhs.begin_ + i, colors, count);
+      this->parent_->set_pixels(this->begin_ + i, colors, count);
     }
   } else {
     // Copy from right
-    for (int32_t i = this->size() - 1; i >= 0; i--) {
-      (*this)[i].set(rhs[i].get());
+    for (int32_t end = size; end > 0; end -= ADDRESSABLE_LIGHT_CHUNK_SIZE) {
+      const int32_t count = std::min(end, ADDRESSABLE_LIGHT_CHUNK_SIZE);
+      rhs.parent_->get_pixels(rhs.begin_ + end - count, colors, count);
+      this->parent_->set_pixels(this->begin_ + end - count, colors, count);
     }
   }
 
@@ -15,37 +15,9 @@ void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
   auto values = state.remote_values;
   auto traits = state.get_output()->get_traits();
 
-  switch (values.get_color_mode()) {
-    case ColorMode::UNKNOWN:  // don't need to set color mode if we don't know it
-      break;
-    case ColorMode::ON_OFF:
-      root["color_mode"] = "onoff";
-      break;
-    case ColorMode::BRIGHTNESS:
-      root["color_mode"] = "brightness";
-      break;
-    case ColorMode::WHITE:  // not supported by HA in MQTT
-      root["color_mode"] = "white";
-      break;
-    case ColorMode::COLOR_TEMPERATURE:
-      root["color_mode"] = "color_temp";
-      break;
-    case ColorMode::COLD_WARM_WHITE:  // not supported by HA
-      root["color_mode"] = "cwww";
-      break;
-    case ColorMode::RGB:
-      root["color_mode"] = "rgb";
-      break;
-    case ColorMode::RGB_WHITE:
-      root["color_mode"] = "rgbw";
-      break;
-    case ColorMode::RGB_COLOR_TEMPERATURE:  // not supported by HA
-      root["color_mode"] = "rgbct";
-      break;
-    case ColorMode::RGB_COLD_WARM_WHITE:
-      root["color_mode"] = "rgbww";
-      break;
-  }
+  const char *color_mode = color_mode_to_string(values.get_color_mode());
+  if (color_mode != nullptr)
+    root["color_mode"] = color_mode;
 
   if (values.get_color_mode() & ColorCapability::ON_OFF)
     root["state"] = (values.get_state() != 0.0f) ? "ON" : "OFF";
@@ -72,6 +44,67 @@ void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
   }
 }
 
+void LightJSONSchema::dump_json(LightState &state, json::JsonWriter &writer) {
+  if (state.supports_effects())
+    writer.member("effect", state.get_effect_name());
+
+  auto values = state.remote_values;
+  const char *color_mode = color_mode_to_string(values.get_color_mode());
+  if (color_mode != nullptr)
+    writer.member("color_mode", color_mode);
+
+  if (values.get_color_mode() & ColorCapability::ON_OFF)
+    writer.member("state", (values.get_state() != 0.0f) ? "ON" : "OFF");
+  if (values.get_color_mode() & ColorCapability::BRIGHTNESS)
+    writer.member("brightness", uint8_t(values.get_brightness() * 255));
+
+  // Same members as the JsonObject version, but the color object has to be written in one piece
+  writer.begin_object("color");
+  if (values.get_color_mode() & ColorCapability::RGB) {
+    writer.member("r", uint8_t(values.get_color_brightness() * values.get_red() * 255));
+    writer.member("g", uint8_t(values.get_color_brightness() * values.get_green() * 255));
+    writer.member("b", uint8_t(values.get_color_brightness() * values.get_blue() * 255));
+  }
+  if (values.get_color_mode() & ColorCapability::WHITE)
+    writer.member("w", uint8_t(values.get_white() * 255));
+  if (values.get_color_mode() & ColorCapability::COLD_WARM_WHITE) {
+    writer.member("c", uint8_t(values.get_cold_white() * 255));
+    writer.member("w", uint8_t(values.get_warm_white() * 255));
+  }
+  writer.end_object();
+
+  if (values.get_color_mode() & ColorCapability::WHITE)
+    writer.member("white_value", uint8_t(values.get_white() * 255));  // legacy API
+  if (values.get_color_mode() & ColorCapability::COLOR_TEMPERATURE)
+    writer.member("color_temp", uint32_t(values.get_color_temperature()));
+}
+
+const char *LightJSONSchema::color_mode_to_string(ColorMode color_mode) {
+  switch (color_mode) {
+    case ColorMode::UNKNOWN:  // don't need to set color mode if we don't know it
+      return nullptr;
+    case ColorMode::ON_OFF:
+      return "onoff";
+    case ColorMode::BRIGHTNESS:
+      return "brightness";
+    case ColorMode::WHITE:  // not supported by HA in MQTT
+      return "white";
+    case ColorMode::COLOR_TEMPERATURE:
+      return "color_temp";
+    case ColorMode::COLD_WARM_WHITE:  // not supported by HA
+      return "cwww";
+    case ColorMode::RGB:
+      return "rgb";
+    case ColorMode::RGB_WHITE:
+      return "rgbw";
+    case ColorMode::RGB_COLOR_TEMPERATURE:  // not supported by HA
+      return "rgbct";
+    case ColorMode::RGB_COLD_WARM_WHITE:
+      return "rgbww";
+  }
+  return nullptr;
+}
+
 void LightJSONSchema::parse_color_json(LightState &state, LightCall &call, JsonObject root) {
   if (root.containsKey("state")) {
     auto val = parse_on_off(root["state"]);
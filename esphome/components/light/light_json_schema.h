@@ -5,6 +5,7 @@
 #ifdef USE_JSON
 
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "light_call.h"
 #include "light_state.h"
 
@@ -15,10 +16,13 @@ class LightJSONSchema {
  public:
   /// Dump the state of a light as JSON.
   static void dump_json(LightState &state, JsonObject root);
+  /// Write the state of a light as members of the object currently open in \p writer.
+  static void dump_json(LightState &state, json::JsonWriter &writer);
   /// Parse the JSON state of a light to a LightCall.
   static void parse_json(LightState &state, LightCall &call, JsonObject root);
 
  protected:
+  static const char *color_mode_to_string(ColorMode color_mode);
   static void parse_color_json(LightState &state, LightCall &call, JsonObject root);
 };
 
@@ -173,6 +173,7 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_TASK_LOG_BUFFER_SIZE = "task_log_buffer_size"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -222,6 +223,9 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.SplitDefault(CONF_TASK_LOG_BUFFER_SIZE, esp32=4096): cv.All(
+                cv.only_on_esp32, cv.validate_bytes
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
@@ -250,6 +254,10 @@ async def to_code(config):
     for tag, log_level in config[CONF_LOGS].items():
         cg.add(log.set_log_level(tag, LOG_LEVELS[log_level]))
 
+    if task_log_buffer_size := config.get(CONF_TASK_LOG_BUFFER_SIZE):
+        cg.add(log.init_task_log_buffer(task_log_buffer_size))
+        cg.add_define("USE_LOGGER_TASK_LOG_BUFFER")
+
     cg.add_define("USE_LOGGER")
     this_severity = LOG_LEVEL_SEVERITY.index(level)
     cg.add_build_flag(f"-DESPHOME_LOG_LEVEL={LOG_LEVELS[level]}")
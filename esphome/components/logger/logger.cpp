@@ -31,7 +31,22 @@ static const char *const LOG_LEVEL_LETTERS[] = {
     "VV",  // VERY_VERBOSE
 };
 
-void Logger::write_header_(int level, const char *tag, int line) {
+const char *Logger::get_thread_name_() {
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
+  TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
+  if (current_task == this->main_task_)
+    return nullptr;
+#if defined(USE_ESP32)
+  return pcTaskGetName(current_task);
+#else
+  return pcTaskGetTaskName(current_task);
+#endif
+#else
+  return nullptr;
+#endif
+}
+
+void Logger::write_header_(int level, const char *tag, int line, const char *thread_name) {
   if (level < 0)
     level = 0;
   if (level > 7)
@@ -39,35 +54,64 @@ void Logger::write_header_(int level, const char *tag, int line) {
 
   const char *color = LOG_LEVEL_COLORS[level];
   const char *letter = LOG_LEVEL_LETTERS[level];
-#if defined(USE_ESP32) || defined(USE_LIBRETINY)
-  TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
-#else
-  void *current_task = nullptr;
-#endif
-  if (current_task == main_task_) {
+  if (thread_name == nullptr) {
     this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
   } else {
-    const char *thread_name = "";  // NOLINT(clang-analyzer-deadcode.DeadStores)
-#if defined(USE_ESP32)
-    thread_name = pcTaskGetName(current_task);
-#elif defined(USE_LIBRETINY)
-    thread_name = pcTaskGetTaskName(current_task);
-#endif
     this->printf_to_buffer_("%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
                             ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
   }
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+
+  const char *thread_name = this->get_thread_name_();
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  if (thread_name != nullptr && this->task_log_buffer_ != nullptr) {
+    // Other tasks must not share tx_buffer_ or run the log callbacks, hand the message over to the main loop
+    if (this->task_log_buffer_->push(level, tag, line, thread_name, format, args))
+      this->wake_loop();
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
+  bool raw_handled = false;
+#ifdef USE_LOGGER_RAW_CALLBACK
+  for (auto &callback : this->raw_log_callbacks_) {
+    va_list args_copy;
+    va_copy(args_copy, args);
+    raw_handled |= callback(level, tag, line, format, args_copy);
+    va_end(args_copy);
+  }
+#endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  if (this->task_log_buffer_ != nullptr) {
+    // Queue the message so serial and the log callbacks run from loop(). Errors, messages logged during setup and
+    // messages that don't fit are written right away, after everything queued before them, so the last lines before
+    // a crash or a boot loop still make it out.
+    if (level > ESPHOME_LOG_LEVEL_ERROR && App.is_setup_complete()) {
+      va_list args_copy;
+      va_copy(args_copy, args);
+      const bool queued = this->task_log_buffer_->push_whole(level, tag, line, format, args_copy, raw_handled);
+      va_end(args_copy);
+      if (queued) {
+        this->wake_loop();
+        recursion_guard_ = false;
+        return;
+      }
+    }
+    this->drain_task_log_buffer_();
+  }
+#endif
   this->reset_buffer_();
-  this->write_header_(level, tag, line);
+  this->write_header_(level, tag, line, thread_name);
   this->vprintf_to_buffer_(format, args);
   this->write_footer_();
-  this->log_message_(level, tag);
+  this->log_message_(level, tag, 0, raw_handled);
   recursion_guard_ = false;
 }
 #ifdef USE_STORE_LOG_STR_IN_FLASH
@@ -93,7 +137,7 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   uint32_t offset = this->tx_buffer_at_;
 
   // now apply vsnprintf
-  this->write_header_(level, tag, line);
+  this->write_header_(level, tag, line, this->get_thread_name_());
   this->vprintf_to_buffer_(this->tx_buffer_, args);
   this->write_footer_();
   this->log_message_(level, tag, offset);
@@ -107,7 +151,7 @@ int HOT Logger::level_for(const char *tag) {
   return this->current_level_;
 }
 
-void HOT Logger::log_message_(int level, const char *tag, int offset) {
+void HOT Logger::log_message_(int level, const char *tag, int offset, bool raw_handled) {
   // remove trailing newline
   if (this->tx_buffer_[this->tx_buffer_at_ - 1] == '\n') {
     this->tx_buffer_at_--;
@@ -131,7 +175,9 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
     return;
 #endif
 
+  this->raw_handled_ = raw_handled;
   this->log_callback_.call(level, tag, msg);
+  this->raw_handled_ = false;
 }
 
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
@@ -142,9 +188,54 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate
 #endif
 }
 
-#ifdef USE_LOGGER_USB_CDC
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+void Logger::init_task_log_buffer(size_t size) {
+  this->task_log_buffer_ = make_unique<TaskLogBuffer>(size);
+#if !(defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO))
+  // loop() only drains the buffer, every queued message wakes it
+  this->set_loop_on_wake(true);
+#endif
+}
+
+void Logger::drain_task_log_buffer_() {
+  while (this->task_log_buffer_->pop([this](const TaskLogBuffer::Message &msg) {
+    this->reset_buffer_();
+    // messages from the main task are queued without a thread name
+    this->write_header_(msg.level, msg.tag, msg.line, msg.thread_name[0] != '\0' ? msg.thread_name : nullptr);
+    this->write_to_buffer_(msg.text, strlen(msg.text));
+    this->write_footer_();
+    this->log_message_(msg.level, msg.tag, 0, msg.raw_handled);
+  })) {
+  }
+}
+
+void Logger::process_task_log_buffer_() {
+  if (this->task_log_buffer_ == nullptr || this->recursion_guard_)
+    return;
+
+  this->recursion_guard_ = true;
+  this->drain_task_log_buffer_();
+  this->recursion_guard_ = false;
+
+  const uint32_t dropped = this->task_log_buffer_->take_dropped();
+  if (dropped != 0) {
+    this->dropped_messages_ += dropped;
+    ESP_LOGW(TAG, "Dropped %" PRIu32 " log messages from other tasks, consider increasing task_log_buffer_size",
+             dropped);
+  }
+}
+#endif
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+void Logger::on_shutdown() { this->process_task_log_buffer_(); }
+#endif
+
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_TASK_LOG_BUFFER)
 void Logger::loop() {
-#ifdef USE_ARDUINO
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  this->process_task_log_buffer_();
+#endif
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
   if (this->uart_ != UART_SELECTION_USB_CDC) {
     return;
   }
@@ -181,6 +272,11 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %" PRIu32, this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", get_uart_selection_());
 #endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  if (this->task_log_buffer_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Task Log Buffer Slots: %u", (unsigned) this->task_log_buffer_->get_slot_count());
+  }
+#endif
 
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.first.c_str(), LOG_LEVELS[it.second]);
@@ -8,6 +8,10 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+#include "task_log_buffer.h"
+#endif
+
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
 #include <HardwareSerial.h>
@@ -57,8 +61,20 @@ enum UARTSelection {
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_TASK_LOG_BUFFER)
   void loop() override;
+#endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  /** Queue log messages in a buffer of \p size bytes, to be written to serial and the log callbacks from loop().
+   *
+   * Messages from other tasks are dropped when the buffer is full. Messages from the main task are written right away
+   * instead, after everything queued before them, and so are messages too long for a buffer slot, errors and
+   * messages logged before setup() has finished.
+   */
+  void init_task_log_buffer(size_t size);
+  void on_shutdown() override;
+  /// Total number of messages from other tasks dropped because the buffer was full.
+  uint32_t get_dropped_messages() const { return this->dropped_messages_; }
 #endif
   /// Manually set the baud rate for serial, set to 0 to disable.
   void set_baud_rate(uint32_t baud_rate);
@@ -91,6 +107,20 @@ class Logger : public Component {
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+#ifdef USE_LOGGER_RAW_CALLBACK
+  /** Register a callback that receives the unformatted arguments of log messages from the main task.
+   *
+   * It is called when the message is logged. The regular log callbacks for the same message may run later, from
+   * loop(), when the message was queued. The callback returns true if it handled the message, which the regular
+   * callbacks can query with is_raw_handled(). Messages from other tasks and format strings stored in flash only
+   * reach the regular callbacks.
+   */
+  void add_on_raw_log_callback(std::function<bool(int, const char *, int, const char *, va_list)> &&callback) {
+    this->raw_log_callbacks_.push_back(std::move(callback));
+  }
+#endif
+  /// Whether a raw log callback handled the message the regular log callbacks are currently called for.
+  bool is_raw_handled() const { return this->raw_handled_; }
 
   // add a listener for log level changes
   void add_listener(std::function<void(int)> &&callback) { this->level_callback_.add(std::move(callback)); }
@@ -103,9 +133,11 @@ class Logger : public Component {
 #endif
 
  protected:
-  void write_header_(int level, const char *tag, int line);
+  /// Name of the calling task, or nullptr when called from the main task.
+  const char *get_thread_name_();
+  void write_header_(int level, const char *tag, int line, const char *thread_name);
   void write_footer_();
-  void log_message_(int level, const char *tag, int offset = 0);
+  void log_message_(int level, const char *tag, int offset = 0, bool raw_handled = false);
   void write_msg_(const char *msg);
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
@@ -149,6 +181,11 @@ class Logger : public Component {
 #ifndef USE_HOST
   const char *get_uart_selection_();
 #endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  void process_task_log_buffer_();
+  /// Write all queued messages, the caller must hold the recursion guard.
+  void drain_task_log_buffer_();
+#endif
 
   uint32_t baud_rate_;
   char *tx_buffer_{nullptr};
@@ -168,10 +205,18 @@ class Logger : public Component {
 #endif
   std::map<std::string, int> log_levels_{};
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
+#ifdef USE_LOGGER_RAW_CALLBACK
+  std::vector<std::function<bool(int, const char *, int, const char *, va_list)>> raw_log_callbacks_;
+#endif
+  bool raw_handled_{false};
   int current_level_{ESPHOME_LOG_LEVEL_VERY_VERBOSE};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
   void *main_task_ = nullptr;
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  std::unique_ptr<TaskLogBuffer> task_log_buffer_;
+  uint32_t dropped_messages_{0};
+#endif
   CallbackManager<void(int)> level_callback_{};
 };
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -0,0 +1,65 @@
+#include "task_log_buffer.h"
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+TaskLogBuffer::TaskLogBuffer(size_t size) {
+  size_t count = 2;
+  while (count * 2 * sizeof(Slot) <= size)
+    count *= 2;
+  this->mask_ = count - 1;
+  this->slots_ = std::unique_ptr<Slot[]>(new Slot[count]);  // NOLINT
+  for (size_t i = 0; i < count; i++)
+    this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool TaskLogBuffer::push_(int level, const char *tag, int line, const char *thread_name, const char *format,
+                          va_list args, bool whole, bool raw_handled) {
+  // Reserve a slot: a slot is free for position pos once its sequence equals pos
+  uint32_t pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+  Slot *slot;
+  while (true) {
+    slot = &this->slots_[pos & this->mask_];
+    const uint32_t seq = slot->sequence.load(std::memory_order_acquire);
+    const int32_t diff = static_cast<int32_t>(seq - pos);
+    if (diff == 0) {
+      if (this->enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      // the consumer has not released this slot yet, buffer is full
+      if (!whole)
+        this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  Message &msg = slot->message;
+  msg.tag = tag;
+  msg.line = line;
+  msg.level = level;
+  msg.raw_handled = raw_handled;
+  strncpy(msg.thread_name, thread_name != nullptr ? thread_name : "", MAX_THREAD_NAME_LENGTH - 1);
+  msg.thread_name[MAX_THREAD_NAME_LENGTH - 1] = '\0';
+  int ret = vsnprintf(msg.text, sizeof(msg.text), format, args);
+  if (ret < 0)
+    msg.text[0] = '\0';
+  // the slot can't be given back once later slots are reserved, so it is skipped by the consumer instead
+  const bool skip = whole && ret > static_cast<int>(MAX_MESSAGE_LENGTH);
+  if (skip)
+    msg.level = SKIPPED_LEVEL;
+
+  // publish to the consumer
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return !skip;
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace logger {
+
+/** Bounded lock-free multi-producer queue of formatted log messages.
+ *
+ * Any task can push() a message without taking a lock, a single consumer (the main loop) pops them in order.
+ * Each message occupies one fixed-size slot and longer messages are truncated. When every slot is in use the
+ * message is dropped and counted instead of blocking the producer. The consumer itself uses push_whole(), which
+ * fails instead so it can write the message directly.
+ */
+class TaskLogBuffer {
+ public:
+  static const size_t MAX_MESSAGE_LENGTH = 160;
+  static const size_t MAX_THREAD_NAME_LENGTH = 16;
+
+  struct Message {
+    const char *tag;
+    uint16_t line;
+    uint8_t level;
+    /// Whether the raw log callbacks already handled this message when it was logged.
+    bool raw_handled;
+    char thread_name[MAX_THREAD_NAME_LENGTH];
+    char text[MAX_MESSAGE_LENGTH + 1];
+  };
+
+  /// Create a buffer using about \p size bytes, the slot count is rounded down to a power of two.
+  explicit TaskLogBuffer(size_t size);
+
+  /// Format a message into a free slot. Returns false and counts the drop if all slots are in use.
+  bool push(int level, const char *tag, int line, const char *thread_name, const char *format, va_list args) {
+    return this->push_(level, tag, line, thread_name, format, args, false, false);
+  }
+  /** Format a message into a free slot without truncating it or counting drops.
+   *
+   * Returns false if all slots are in use or the message is longer than MAX_MESSAGE_LENGTH. \p args is consumed
+   * in the latter case. \p raw_handled is passed on to the consumer in Message::raw_handled.
+   */
+  bool push_whole(int level, const char *tag, int line, const char *format, va_list args, bool raw_handled) {
+    return this->push_(level, tag, line, nullptr, format, args, true, raw_handled);
+  }
+
+  /// Pass the oldest message to \p callback and release its slot. Only call from the consumer.
+  template<typename F> bool pop(F &&callback) {
+    Slot &slot = this->slots_[this->dequeue_pos_ & this->mask_];
+    const uint32_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(seq - (this->dequeue_pos_ + 1)) < 0)
+      return false;  // empty, or the producer of this slot has not finished writing it
+    if (slot.message.level != SKIPPED_LEVEL)
+      callback(slot.message);
+    slot.sequence.store(this->dequeue_pos_ + this->mask_ + 1, std::memory_order_release);
+    this->dequeue_pos_++;
+    return true;
+  }
+
+  /// Number of messages dropped since the last call.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
+  size_t get_slot_count() const { return this->mask_ + 1; }
+
+ protected:
+  /// Level of a slot that was reserved by push_whole() but not used.
+  static const uint8_t SKIPPED_LEVEL = 0xFF;
+
+  bool push_(int level, const char *tag, int line, const char *thread_name, const char *format, va_list args,
+             bool whole, bool raw_handled);
+
+  struct Slot {
+    std::atomic<uint32_t> sequence;
+    Message message;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  uint32_t mask_;
+  std::atomic<uint32_t> enqueue_pos_{0};
+  uint32_t dequeue_pos_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
@@ -2,6 +2,7 @@
 
 #ifdef USE_MQTT
 
+#include <algorithm>
 #include <utility>
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
@@ -26,6 +27,8 @@ namespace esphome {
 namespace mqtt {
 
 static const char *const TAG = "mqtt";
+/// Matching subscriptions of an incoming message that are collected without allocating.
+static const size_t MAX_STACK_MATCHES = 8;
 
 MQTTClientComponent::MQTTClientComponent() {
   global_mqtt_client = this;
@@ -415,6 +418,12 @@ void MQTTClientComponent::resubscribe_subscriptions_() {
   }
 }
 
+void MQTTClientComponent::add_subscription_(MQTTSubscription &&subscription) {
+  this->resubscribe_subscription_(&subscription);
+  this->subscription_trie_.insert(subscription.topic, this->subscriptions_.size());
+  this->subscriptions_.push_back(std::move(subscription));
+}
+
 void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t callback, uint8_t qos) {
   MQTTSubscription subscription{
       .topic = topic,
@@ -422,9 +431,9 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
       .callback = std::move(callback),
       .subscribed = false,
       .resubscribe_timeout = 0,
+      .unsubscribed = false,
   };
-  this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  this->add_subscription_(std::move(subscription));
 }
 
 void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos) {
@@ -440,9 +449,9 @@ void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_js
       .callback = f,
       .subscribed = false,
       .resubscribe_timeout = 0,
+      .unsubscribed = false,
   };
-  this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  this->add_subscription_(std::move(subscription));
 }
 
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
@@ -456,14 +465,30 @@ void MQTTClientComponent::unsubscribe(const std::string &topic) {
     this->status_momentary_warning("unsubscribe", 1000);
   }
 
-  auto it = subscriptions_.begin();
-  while (it != subscriptions_.end()) {
-    if (it->topic == topic) {
-      it = subscriptions_.erase(it);
-    } else {
-      ++it;
+  // Only mark the subscriptions here, erasing them would shift the indices a running dispatch is using and could
+  // destroy the callback that is calling unsubscribe()
+  for (auto &subscription : this->subscriptions_) {
+    if (subscription.topic == topic) {
+      subscription.unsubscribed = true;
+      this->has_unsubscribed_ = true;
     }
   }
+  if (!this->dispatching_)
+    this->remove_unsubscribed_();
+}
+
+void MQTTClientComponent::remove_unsubscribed_() {
+  if (!this->has_unsubscribed_)
+    return;
+  this->has_unsubscribed_ = false;
+  this->subscriptions_.erase(std::remove_if(this->subscriptions_.begin(), this->subscriptions_.end(),
+                                            [](const MQTTSubscription &sub) { return sub.unsubscribed; }),
+                             this->subscriptions_.end());
+
+  // the indices of the remaining subscriptions have shifted
+  this->subscription_trie_.clear();
+  for (size_t i = 0; i < this->subscriptions_.size(); i++)
+    this->subscription_trie_.insert(this->subscriptions_[i].topic, i);
 }
 
 // Publish
@@ -473,30 +498,35 @@ bool MQTTClientComponent::publish(const std::string &topic, const std::string &p
 
 bool MQTTClientComponent::publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
                                   bool retain) {
-  return publish({.topic = topic, .payload = payload, .qos = qos, .retain = retain});
+  return this->publish(topic.c_str(), payload, payload_length, qos, retain);
 }
 
 bool MQTTClientComponent::publish(const MQTTMessage &message) {
+  return this->publish(message.topic.c_str(), message.payload.data(), message.payload.size(), message.qos,
+                       message.retain);
+}
+
+bool MQTTClientComponent::publish(const char *topic, const char *payload, size_t payload_length, uint8_t qos,
+                                  bool retain) {
   if (!this->is_connected()) {
     // critical components will re-transmit their messages
     return false;
   }
-  bool logging_topic = this->log_message_.topic == message.topic;
-  bool ret = this->mqtt_backend_.publish(message);
+  bool logging_topic = this->log_message_.topic == topic;
+  bool ret = this->mqtt_backend_.publish(topic, payload, payload_length, qos, retain);
   delay(0);
   if (!ret && !logging_topic && this->is_connected()) {
     delay(0);
-    ret = this->mqtt_backend_.publish(message);
+    ret = this->mqtt_backend_.publish(topic, payload, payload_length, qos, retain);
     delay(0);
   }
 
   if (!logging_topic) {
     if (ret) {
-      ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d qos=%d)", message.topic.c_str(), message.payload.c_str(),
-               message.retain, message.qos);
+      ESP_LOGV(TAG, "Publish(topic='%s' payload='%.*s' retain=%d qos=%d)", topic, (int) payload_length, payload,
+               retain, qos);
     } else {
-      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", message.topic.c_str(),
-               message.payload.length());
+      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", topic, payload_length);
       this->status_momentary_warning("publish", 1000);
     }
   }
@@ -508,6 +538,13 @@ bool MQTTClientComponent::publish_json(const std::string &topic, const json::jso
   return this->publish(topic, message, qos, retain);
 }
 
+bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos,
+                                       bool retain) {
+  // The backends copy the payload before publish() returns, so the buffer can be reused right away
+  json::write_json(this->json_buffer_, f);
+  return this->publish(topic, this->json_buffer_, qos, retain);
+}
+
 void MQTTClientComponent::enable() {
   if (this->state_ != MQTT_CLIENT_DISABLED)
     return;
@@ -525,73 +562,34 @@ void MQTTClientComponent::disable() {
   this->on_shutdown();
 }
 
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
-
-    return topic_match(message, subscription, is_normal, true);
-  }
-
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
-  }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match(message, subscription, is_normal, past_separator);
-}
-
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
-}
-
 void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
 #ifdef USE_ESP8266
   // on ESP8266, this is called in lwIP/AsyncTCP task; some components do not like running
   // from a different task.
   this->defer([this, topic, payload]() {
 #endif
-    for (auto &subscription : this->subscriptions_) {
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
+    // Usually only one or two subscriptions match, more than fit on the stack are rare enough to allocate
+    uint16_t stack_matches[MAX_STACK_MATCHES];
+    uint16_t *matches = stack_matches;
+    std::vector<uint16_t> heap_matches;
+    size_t count = this->subscription_trie_.match(topic.c_str(), stack_matches, MAX_STACK_MATCHES);
+    if (count > MAX_STACK_MATCHES) {
+      heap_matches.resize(count);
+      matches = heap_matches.data();
+      this->subscription_trie_.match(topic.c_str(), matches, count);
+    }
+
+    // Subscriptions are only appended while dispatching, so the indices stay valid
+    const bool nested = this->dispatching_;
+    this->dispatching_ = true;
+    for (size_t i = 0; i < count; i++) {
+      // a callback may have unsubscribed
+      if (!this->subscriptions_[matches[i]].unsubscribed)
+        this->subscriptions_[matches[i]].callback(topic, payload);
     }
+    this->dispatching_ = nested;
+    if (!nested)
+      this->remove_unsubscribed_();
 #ifdef USE_ESP8266
   });
 #endif
@@ -8,7 +8,9 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/ip_address.h"
+#include "mqtt_topic_trie.h"
 #if defined(USE_ESP32)
 #include "mqtt_backend_esp32.h"
 #elif defined(USE_ESP8266)
@@ -42,6 +44,8 @@ struct MQTTSubscription {
   mqtt_callback_t callback;
   bool subscribed;
   uint32_t resubscribe_timeout;
+  /// Unsubscribed while a message was dispatched, erased once the dispatch is done.
+  bool unsubscribed;
 };
 
 /// internal struct for MQTT credentials.
@@ -221,6 +225,9 @@ class MQTTClientComponent : public Component {
   bool publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos = 0,
                bool retain = false);
 
+  /// Publish a MQTT message without copying the topic or payload.
+  bool publish(const char *topic, const char *payload, size_t payload_length, uint8_t qos = 0, bool retain = false);
+
   /** Construct and send a JSON MQTT message.
    *
    * @param topic The topic.
@@ -229,6 +236,9 @@ class MQTTClientComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false);
 
+  /// Write and send a JSON MQTT message with a JsonWriter, the payload buffer is reused between messages.
+  bool publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos = 0, bool retain = false);
+
   /// Setup the MQTT client, registering a bunch of callbacks and attempting to connect.
   void setup() override;
   void dump_config() override;
@@ -286,6 +296,9 @@ class MQTTClientComponent : public Component {
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
+  void add_subscription_(MQTTSubscription &&subscription);
+  /// Erase the subscriptions that were unsubscribed during a dispatch and re-index the rest.
+  void remove_unsubscribed_();
 
   MQTTCredentials credentials_;
   /// The last will message. Disabled optional denotes it being default and
@@ -311,9 +324,17 @@ class MQTTClientComponent : public Component {
   std::string topic_prefix_{};
   MQTTMessage log_message_;
   std::string payload_buffer_;
+  /// Outgoing JSON payload written by publish_json() with a JsonWriter.
+  std::string json_buffer_;
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  /// Index of subscriptions_ by topic filter.
+  MQTTTopicTrie subscription_trie_;
+  /// A message is being passed to the subscription callbacks, unsubscribe() must not move subscriptions.
+  bool dispatching_{false};
+  /// Some subscriptions are marked as unsubscribed.
+  bool has_unsubscribed_{false};
 #if defined(USE_ESP32)
   MQTTBackendESP32 mqtt_backend_;
 #elif defined(USE_ESP8266)
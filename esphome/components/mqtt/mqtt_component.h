@@ -122,6 +122,21 @@ class MQTTComponent : public Component {
    */
   bool publish(const std::string &topic, const std::string &payload);
 
+  /** Send a MQTT message without copying the payload.
+   *
+   * @param topic The topic.
+   * @param payload The payload.
+   * @param payload_length The length of the payload.
+   */
+  bool publish(const std::string &topic, const char *payload, size_t payload_length);
+
+  /** Send a MQTT message.
+   *
+   * @param topic The topic.
+   * @param payload The null terminated payload.
+   */
+  bool publish(const std::string &topic, const char *payload);
+
   /** Construct and send a JSON MQTT message.
    *
    * @param topic The topic.
@@ -129,6 +144,13 @@ class MQTTComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f);
 
+  /** Write and send a JSON MQTT message with a JsonWriter.
+   *
+   * @param topic The topic.
+   * @param f The Json Message writer.
+   */
+  bool publish_json(const std::string &topic, const json::json_write_t &f);
+
   /** Subscribe to a MQTT topic.
    *
    * @param topic The topic. Wildcards are currently not supported.
@@ -181,10 +203,10 @@ class MQTTComponent : public Component {
   virtual bool is_disabled_by_default() const;
 
   /// Get the MQTT topic that new states will be shared to.
-  std::string get_state_topic_() const;
+  const std::string &get_state_topic_() const;
 
   /// Get the MQTT topic for listening to commands.
-  std::string get_command_topic_() const;
+  const std::string &get_command_topic_() const;
 
   bool is_connected_() const;
 
@@ -198,11 +220,16 @@ class MQTTComponent : public Component {
 
   StringRef custom_state_topic_{};
   StringRef custom_command_topic_{};
+  /// The state and command topics only depend on the configuration, they are built once on first use.
+  mutable std::string state_topic_{};
+  mutable std::string command_topic_{};
 
   std::unique_ptr<Availability> availability_;
 
   bool has_custom_state_topic_{false};
   bool has_custom_command_topic_{false};
+  mutable bool state_topic_built_{false};
+  mutable bool command_topic_built_{false};
 
   bool command_retain_{false};
   bool retain_{true};
@@ -33,7 +33,7 @@ MQTTJSONLightComponent::MQTTJSONLightComponent(LightState *state) : state_(state
 
 bool MQTTJSONLightComponent::publish_state_() {
   return this->publish_json(this->get_state_topic_(),
-                            [this](JsonObject root) { LightJSONSchema::dump_json(*this->state_, root); });
+                            [this](json::JsonWriter &writer) { LightJSONSchema::dump_json(*this->state_, writer); });
 }
 LightState *MQTTJSONLightComponent::get_state() const { return this->state_; }
 
@@ -72,7 +72,9 @@ bool MQTTSensorComponent::publish_state(float value) {
   if (mqtt::global_mqtt_client->is_publish_nan_as_none() && std::isnan(value))
     return this->publish(this->get_state_topic_(), "None");
   int8_t accuracy = this->sensor_->get_accuracy_decimals();
-  return this->publish(this->get_state_topic_(), value_accuracy_to_string(value, accuracy));
+  char buffer[32];
+  int len = value_accuracy_to_buf(buffer, sizeof(buffer), value, accuracy);
+  return this->publish(this->get_state_topic_(), buffer, std::min<size_t>(len, sizeof(buffer) - 1));
 }
 std::string MQTTSensorComponent::unique_id() { return this->sensor_->unique_id(); }
 
@@ -0,0 +1,107 @@
+#include "mqtt_topic_trie.h"
+
+#ifdef USE_MQTT
+
+#include <algorithm>
+#include <cstring>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace mqtt {
+
+static bool is_level(const std::string &name, const char *level, size_t len) {
+  return name.compare(0, std::string::npos, level, len) == 0;
+}
+
+/// Find where a level of a topic, which isn't null terminated, is or would be in the sorted children of a node.
+template<typename C> static auto find_level(C &children, const char *level, size_t len) -> decltype(children.begin()) {
+  return std::lower_bound(children.begin(), children.end(), level,
+                          [len](const typename C::value_type &child, const char *level) {
+                            return child.first.compare(0, std::string::npos, level, len) < 0;
+                          });
+}
+
+void MQTTTopicTrie::insert(const std::string &filter, uint16_t value) {
+  Node *node = &this->root_;
+  size_t start = 0;
+  while (true) {
+    size_t end = filter.find('/', start);
+    if (end == std::string::npos)
+      end = filter.size();
+    const char *level = filter.c_str() + start;
+    const size_t len = end - start;
+
+    if (len == 1 && *level == '#') {
+      // must be the last level, anything after it is ignored
+      node->multi_level_values.push_back(value);
+      return;
+    }
+    if (len == 1 && *level == '+') {
+      if (node->single_level == nullptr)
+        node->single_level = make_unique<Node>();
+      node = node->single_level.get();
+    } else {
+      auto it = find_level(node->children, level, len);
+      if (it == node->children.end() || !is_level(it->first, level, len))
+        it = node->children.emplace(it, std::string(level, len), make_unique<Node>());
+      node = it->second.get();
+    }
+
+    if (end == filter.size())
+      break;
+    start = end + 1;
+  }
+  node->values.push_back(value);
+}
+
+void MQTTTopicTrie::clear() {
+  this->root_.children.clear();
+  this->root_.single_level.reset();
+  this->root_.values.clear();
+  this->root_.multi_level_values.clear();
+}
+
+size_t MQTTTopicTrie::match(const char *topic, uint16_t *out, size_t max_count) const {
+  Matches matches{out, max_count, 0};
+  match_(this->root_, topic, true, matches);
+  if (matches.count <= max_count)
+    std::sort(out, out + matches.count);
+  return matches.count;
+}
+
+void MQTTTopicTrie::Matches::add(const std::vector<uint16_t> &node_values) {
+  for (uint16_t value : node_values) {
+    if (this->count < this->max_count)
+      this->values[this->count] = value;
+    this->count++;
+  }
+}
+
+void MQTTTopicTrie::match_(const Node &node, const char *level, bool first_level, Matches &out) {
+  if (level == nullptr) {
+    // all levels consumed, `#` also matches the parent level
+    out.add(node.values);
+    out.add(node.multi_level_values);
+    return;
+  }
+
+  const bool wildcards = !first_level || *level != '$';
+  if (wildcards)
+    out.add(node.multi_level_values);
+
+  const char *end = strchr(level, '/');
+  const size_t len = end != nullptr ? end - level : strlen(level);
+  const char *next = end != nullptr ? end + 1 : nullptr;
+
+  auto it = find_level(node.children, level, len);
+  if (it != node.children.end() && is_level(it->first, level, len))
+    match_(*it->second, next, false, out);
+  if (wildcards && node.single_level != nullptr)
+    match_(*node.single_level, next, false, out);
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
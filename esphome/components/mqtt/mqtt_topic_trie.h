@@ -0,0 +1,64 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/** Index of subscription topic filters, organized by topic level.
+ *
+ * Each filter is stored as a path of its levels, with `+` and `#` as separate branches. Matching a topic walks
+ * its levels once instead of comparing it against every filter, so the cost depends on the topic depth and the
+ * number of wildcard branches, not on the number of subscriptions.
+ */
+class MQTTTopicTrie {
+ public:
+  /// Add a topic filter, \p value is reported by match() for every topic it matches.
+  void insert(const std::string &filter, uint16_t value);
+  void clear();
+  /** Store the values of the filters matching \p topic in \p out, in ascending order.
+   *
+   * Follows the MQTT wildcard rules: `+` matches exactly one level, `#` matches the level it is at (including its
+   * parent) and everything below, and wildcards at the first level don't match topics starting with `$`.
+   *
+   * @return The number of matching filters. If it is larger than \p max_count, \p out holds an unspecified subset
+   *         and the call has to be repeated with a buffer that is large enough.
+   */
+  size_t match(const char *topic, uint16_t *out, size_t max_count) const;
+
+ protected:
+  struct Node {
+    /// Literal levels, sorted by name.
+    std::vector<std::pair<std::string, std::unique_ptr<Node>>> children;
+    std::unique_ptr<Node> single_level;
+    /// Filters ending at this node.
+    std::vector<uint16_t> values;
+    /// Filters ending with `#` below this node.
+    std::vector<uint16_t> multi_level_values;
+  };
+
+  struct Matches {
+    uint16_t *values;
+    size_t max_count;
+    size_t count;
+
+    void add(const std::vector<uint16_t> &node_values);
+  };
+
+  static void match_(const Node &node, const char *level, bool first_level, Matches &out);
+
+  Node root_;
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
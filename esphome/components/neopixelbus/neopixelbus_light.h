@@ -115,6 +115,26 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return traits;
   }
 
+  void set_pixels(int32_t from, const Color *colors, int32_t count) override {
+    uint8_t *base = this->controller_->Pixels() + 3ULL * light::interpret_index(from, this->size());
+    for (int32_t i = 0; i < count; i++, base += 3) {
+      base[this->rgb_offsets_[0]] = this->correction_.color_correct_red(colors[i].red);
+      base[this->rgb_offsets_[1]] = this->correction_.color_correct_green(colors[i].green);
+      base[this->rgb_offsets_[2]] = this->correction_.color_correct_blue(colors[i].blue);
+    }
+  }
+  void set_pixels_rgb(int32_t from, const Color *colors, int32_t count) override {
+    this->set_pixels(from, colors, count);
+  }
+  void get_pixels(int32_t from, Color *colors, int32_t count) const override {
+    const uint8_t *base = this->controller_->Pixels() + 3ULL * light::interpret_index(from, this->size());
+    for (int32_t i = 0; i < count; i++, base += 3) {
+      colors[i] = Color(this->correction_.color_uncorrect_red(base[this->rgb_offsets_[0]]),
+                        this->correction_.color_uncorrect_green(base[this->rgb_offsets_[1]]),
+                        this->correction_.color_uncorrect_blue(base[this->rgb_offsets_[2]]));
+    }
+  }
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {  // NOLINT
     uint8_t *base = this->controller_->Pixels() + 3ULL * index;
@@ -132,6 +152,33 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return traits;
   }
 
+  void set_pixels(int32_t from, const Color *colors, int32_t count) override {
+    uint8_t *base = this->controller_->Pixels() + 4ULL * light::interpret_index(from, this->size());
+    for (int32_t i = 0; i < count; i++, base += 4) {
+      base[this->rgb_offsets_[0]] = this->correction_.color_correct_red(colors[i].red);
+      base[this->rgb_offsets_[1]] = this->correction_.color_correct_green(colors[i].green);
+      base[this->rgb_offsets_[2]] = this->correction_.color_correct_blue(colors[i].blue);
+      base[this->rgb_offsets_[3]] = this->correction_.color_correct_white(colors[i].white);
+    }
+  }
+  void set_pixels_rgb(int32_t from, const Color *colors, int32_t count) override {
+    uint8_t *base = this->controller_->Pixels() + 4ULL * light::interpret_index(from, this->size());
+    for (int32_t i = 0; i < count; i++, base += 4) {
+      base[this->rgb_offsets_[0]] = this->correction_.color_correct_red(colors[i].red);
+      base[this->rgb_offsets_[1]] = this->correction_.color_correct_green(colors[i].green);
+      base[this->rgb_offsets_[2]] = this->correction_.color_correct_blue(colors[i].blue);
+    }
+  }
+  void get_pixels(int32_t from, Color *colors, int32_t count) const override {
+    const uint8_t *base = this->controller_->Pixels() + 4ULL * light::interpret_index(from, this->size());
+    for (int32_t i = 0; i < count; i++, base += 4) {
+      colors[i] = Color(this->correction_.color_uncorrect_red(base[this->rgb_offsets_[0]]),
+                        this->correction_.color_uncorrect_green(base[this->rgb_offsets_[1]]),
+                        this->correction_.color_uncorrect_blue(base[this->rgb_offsets_[2]]),
+                        this->correction_.color_uncorrect_white(base[this->rgb_offsets_[3]]));
+    }
+  }
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {  // NOLINT
     uint8_t *base = this->controller_->Pixels() + 4ULL * index;
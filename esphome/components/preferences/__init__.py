@@ -8,10 +8,20 @@ preferences_ns = cg.esphome_ns.namespace("preferences")
 IntervalSyncer = preferences_ns.class_("IntervalSyncer", cg.Component)
 
 CONF_FLASH_WRITE_INTERVAL = "flash_write_interval"
+CONF_MIN_KEY_WRITE_INTERVAL = "min_key_write_interval"
+CONF_VOLATILE_MIN_KEY_WRITE_INTERVAL = "volatile_min_key_write_interval"
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(IntervalSyncer),
         cv.Optional(CONF_FLASH_WRITE_INTERVAL, default="60s"): cv.update_interval,
+        # Minimum time between two writes of the same value on periodic syncs, for values
+        # that are normally kept in flash and values that ESP8266 keeps in RTC memory.
+        cv.Optional(CONF_MIN_KEY_WRITE_INTERVAL): cv.All(
+            cv.only_on_esp32, cv.positive_time_period_milliseconds
+        ),
+        cv.Optional(CONF_VOLATILE_MIN_KEY_WRITE_INTERVAL): cv.All(
+            cv.only_on_esp32, cv.positive_time_period_milliseconds
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -20,3 +30,15 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_write_interval(config[CONF_FLASH_WRITE_INTERVAL]))
     await cg.register_component(var, config)
+
+    if (
+        CONF_MIN_KEY_WRITE_INTERVAL in config
+        or CONF_VOLATILE_MIN_KEY_WRITE_INTERVAL in config
+    ):
+        esp32_ns = cg.esphome_ns.namespace("esp32")
+        cg.add(
+            esp32_ns.set_preferences_min_write_interval(
+                config.get(CONF_MIN_KEY_WRITE_INTERVAL, 0),
+                config.get(CONF_VOLATILE_MIN_KEY_WRITE_INTERVAL, 0),
+            )
+        )
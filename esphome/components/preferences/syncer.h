@@ -11,12 +11,12 @@ class IntervalSyncer : public Component {
   void set_write_interval(uint32_t write_interval) { this->write_interval_ = write_interval; }
   void setup() override {
     if (this->write_interval_ != 0) {
-      set_interval(this->write_interval_, []() { global_preferences->sync(); });
+      set_interval(this->write_interval_, []() { global_preferences->sync_periodic(); });
     }
   }
   void loop() override {
     if (this->write_interval_ == 0) {
-      global_preferences->sync();
+      global_preferences->sync_periodic();
     }
   }
   void on_shutdown() override { global_preferences->sync(); }
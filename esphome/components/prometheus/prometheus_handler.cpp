@@ -7,86 +7,84 @@ namespace prometheus {
 
 void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
   AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
-  std::string area = App.get_area();
-  std::string node = App.get_name();
-  std::string friendly_name = App.get_friendly_name();
+  this->label_cursor_ = 0;
 
 #ifdef USE_SENSOR
   this->sensor_type_(stream);
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj, area, node, friendly_name);
+    this->sensor_row_(stream, obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   this->binary_sensor_type_(stream);
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj, area, node, friendly_name);
+    this->binary_sensor_row_(stream, obj);
 #endif
 
 #ifdef USE_FAN
   this->fan_type_(stream);
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj, area, node, friendly_name);
+    this->fan_row_(stream, obj);
 #endif
 
 #ifdef USE_LIGHT
   this->light_type_(stream);
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj, area, node, friendly_name);
+    this->light_row_(stream, obj);
 #endif
 
 #ifdef USE_COVER
   this->cover_type_(stream);
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj, area, node, friendly_name);
+    this->cover_row_(stream, obj);
 #endif
 
 #ifdef USE_SWITCH
   this->switch_type_(stream);
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj, area, node, friendly_name);
+    this->switch_row_(stream, obj);
 #endif
 
 #ifdef USE_LOCK
   this->lock_type_(stream);
   for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj, area, node, friendly_name);
+    this->lock_row_(stream, obj);
 #endif
 
 #ifdef USE_TEXT_SENSOR
   this->text_sensor_type_(stream);
   for (auto *obj : App.get_text_sensors())
-    this->text_sensor_row_(stream, obj, area, node, friendly_name);
+    this->text_sensor_row_(stream, obj);
 #endif
 
 #ifdef USE_NUMBER
   this->number_type_(stream);
   for (auto *obj : App.get_numbers())
-    this->number_row_(stream, obj, area, node, friendly_name);
+    this->number_row_(stream, obj);
 #endif
 
 #ifdef USE_SELECT
   this->select_type_(stream);
   for (auto *obj : App.get_selects())
-    this->select_row_(stream, obj, area, node, friendly_name);
+    this->select_row_(stream, obj);
 #endif
 
 #ifdef USE_MEDIA_PLAYER
   this->media_player_type_(stream);
   for (auto *obj : App.get_media_players())
-    this->media_player_row_(stream, obj, area, node, friendly_name);
+    this->media_player_row_(stream, obj);
 #endif
 
 #ifdef USE_UPDATE
   this->update_entity_type_(stream);
   for (auto *obj : App.get_updates())
-    this->update_entity_row_(stream, obj, area, node, friendly_name);
+    this->update_entity_row_(stream, obj);
 #endif
 
 #ifdef USE_VALVE
   this->valve_type_(stream);
   for (auto *obj : App.get_valves())
-    this->valve_row_(stream, obj, area, node, friendly_name);
+    this->valve_row_(stream, obj);
 #endif
 
   req->send(stream);
@@ -102,25 +100,31 @@ std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
   return item == relabel_map_name_.end() ? obj->get_name() : item->second;
 }
 
-void PrometheusHandler::add_area_label_(AsyncResponseStream *stream, std::string &area) {
-  if (!area.empty()) {
-    stream->print(F("\",area=\""));
-    stream->print(area.c_str());
-  }
-}
-
-void PrometheusHandler::add_node_label_(AsyncResponseStream *stream, std::string &node) {
-  if (!node.empty()) {
-    stream->print(F("\",node=\""));
-    stream->print(node.c_str());
-  }
-}
+const char *PrometheusHandler::entity_labels_(EntityBase *obj) {
+  if (this->label_cursor_ < this->label_entries_.size() && this->label_entries_[this->label_cursor_].obj == obj)
+    return this->label_arena_.c_str() + this->label_entries_[this->label_cursor_++].offset;
 
-void PrometheusHandler::add_friendly_name_label_(AsyncResponseStream *stream, std::string &friendly_name) {
-  if (!friendly_name.empty()) {
-    stream->print(F("\",friendly_name=\""));
-    stream->print(friendly_name.c_str());
+  // First scrape, or the exported entities changed: (re)build the labels from here on
+  if (this->label_cursor_ < this->label_entries_.size()) {
+    this->label_arena_.resize(this->label_entries_[this->label_cursor_].offset);
+    this->label_entries_.resize(this->label_cursor_);
   }
+  const uint32_t offset = this->label_arena_.size();
+  const std::string &area = App.get_area();
+  const std::string &node = App.get_name();
+  const std::string &friendly_name = App.get_friendly_name();
+  this->label_arena_.append("id=\"").append(this->relabel_id_(obj));
+  if (!area.empty())
+    this->label_arena_.append("\",area=\"").append(area);
+  if (!node.empty())
+    this->label_arena_.append("\",node=\"").append(node);
+  if (!friendly_name.empty())
+    this->label_arena_.append("\",friendly_name=\"").append(friendly_name);
+  this->label_arena_.append("\",name=\"").append(this->relabel_name_(obj)).append("\"");
+  this->label_arena_.push_back('\0');
+  this->label_entries_.push_back({obj, offset});
+  this->label_cursor_++;
+  return this->label_arena_.c_str() + offset;
 }
 
 // Type-specific implementation
@@ -129,43 +133,28 @@ void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_sensor_value gauge\n"));
   stream->print(F("#TYPE esphome_sensor_failed gauge\n"));
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
+void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_sensor_failed{"));
+    stream->print(labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
+    stream->print(F("esphome_sensor_value{"));
+    stream->print(labels);
+    stream->print(F(",unit=\""));
     stream->print(obj->get_unit_of_measurement().c_str());
     stream->print(F("\"} "));
     stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
     stream->print(F("\n"));
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_sensor_failed{"));
+    stream->print(labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -176,41 +165,26 @@ void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_binary_sensor_value gauge\n"));
   stream->print(F("#TYPE esphome_binary_sensor_failed gauge\n"));
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj,
-                                           std::string &area, std::string &node, std::string &friendly_name) {
+void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_binary_sensor_failed{"));
+    stream->print(labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_binary_sensor_value{"));
+    stream->print(labels);
+    stream->print(F("} "));
     stream->print(obj->state);
     stream->print(F("\n"));
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_binary_sensor_failed{"));
+    stream->print(labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -222,52 +196,32 @@ void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_fan_speed gauge\n"));
   stream->print(F("#TYPE esphome_fan_oscillation gauge\n"));
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj, std::string &area, std::string &node,
-                                 std::string &friendly_name) {
+void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  const char *labels = this->entity_labels_(obj);
+  stream->print(F("esphome_fan_failed{"));
+  stream->print(labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_fan_value{"));
+  stream->print(labels);
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print(F("\n"));
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_fan_speed{"));
+    stream->print(labels);
+    stream->print(F("} "));
     stream->print(obj->speed);
     stream->print(F("\n"));
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_fan_oscillation{"));
+    stream->print(labels);
+    stream->print(F("} "));
     stream->print(obj->oscillating);
     stream->print(F("\n"));
   }
@@ -280,19 +234,14 @@ void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_light_color gauge\n"));
   stream->print(F("#TYPE esphome_light_effect_active gauge\n"));
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj, std::string &area,
-                                   std::string &node, std::string &friendly_name) {
+void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_light_state{"));
+  stream->print(labels);
+  stream->print(F("} "));
   stream->print(obj->remote_values.is_on());
   stream->print(F("\n"));
   // Brightness and RGBW
@@ -300,76 +249,41 @@ void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightStat
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
+  stream->print(F("esphome_light_color{"));
+  stream->print(labels);
+  stream->print(F(",channel=\"brightness\"} "));
   stream->print(brightness);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
+  stream->print(F("esphome_light_color{"));
+  stream->print(labels);
+  stream->print(F(",channel=\"r\"} "));
   stream->print(r);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
+  stream->print(F("esphome_light_color{"));
+  stream->print(labels);
+  stream->print(F(",channel=\"g\"} "));
   stream->print(g);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
+  stream->print(F("esphome_light_color{"));
+  stream->print(labels);
+  stream->print(F(",channel=\"b\"} "));
   stream->print(b);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
+  stream->print(F("esphome_light_color{"));
+  stream->print(labels);
+  stream->print(F(",channel=\"w\"} "));
   stream->print(w);
   stream->print(F("\n"));
   // Effect
   std::string effect = obj->get_effect_name();
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    stream->print(F("esphome_light_effect_active{"));
+    stream->print(labels);
+    stream->print(F(",effect=\"None\"} 0\n"));
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
+    stream->print(F("esphome_light_effect_active{"));
+    stream->print(labels);
+    stream->print(F(",effect=\""));
     stream->print(effect.c_str());
     stream->print(F("\"} 1\n"));
   }
@@ -381,53 +295,33 @@ void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_cover_value gauge\n"));
   stream->print(F("#TYPE esphome_cover_failed gauge\n"));
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj, std::string &area, std::string &node,
-                                   std::string &friendly_name) {
+void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_cover_failed{"));
+    stream->print(labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_cover_value{"));
+    stream->print(labels);
+    stream->print(F("} "));
     stream->print(obj->position);
     stream->print(F("\n"));
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      add_area_label_(stream, area);
-      add_node_label_(stream, node);
-      add_friendly_name_label_(stream, friendly_name);
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
+      stream->print(F("esphome_cover_tilt{"));
+      stream->print(labels);
+      stream->print(F("} "));
       stream->print(obj->tilt);
       stream->print(F("\n"));
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_cover_failed{"));
+    stream->print(labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -437,27 +331,17 @@ void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_switch_value gauge\n"));
   stream->print(F("#TYPE esphome_switch_failed gauge\n"));
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
+void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  const char *labels = this->entity_labels_(obj);
+  stream->print(F("esphome_switch_failed{"));
+  stream->print(labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_switch_value{"));
+  stream->print(labels);
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print(F("\n"));
 }
@@ -468,27 +352,17 @@ void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_lock_value gauge\n"));
   stream->print(F("#TYPE esphome_lock_failed gauge\n"));
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj, std::string &area, std::string &node,
-                                  std::string &friendly_name) {
+void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  const char *labels = this->entity_labels_(obj);
+  stream->print(F("esphome_lock_failed{"));
+  stream->print(labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_lock_value{"));
+  stream->print(labels);
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print(F("\n"));
 }
@@ -500,43 +374,28 @@ void PrometheusHandler::text_sensor_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_text_sensor_value gauge\n"));
   stream->print(F("#TYPE esphome_text_sensor_failed gauge\n"));
 }
-void PrometheusHandler::text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj, std::string &area,
-                                         std::string &node, std::string &friendly_name) {
+void PrometheusHandler::text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_text_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_text_sensor_failed{"));
+    stream->print(labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_text_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",value=\""));
+    stream->print(F("esphome_text_sensor_value{"));
+    stream->print(labels);
+    stream->print(F(",value=\""));
     stream->print(obj->state.c_str());
     stream->print(F("\"} "));
     stream->print(F("1.0"));
     stream->print(F("\n"));
   } else {
     // Invalid state
-    stream->print(F("esphome_text_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_text_sensor_failed{"));
+    stream->print(labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -547,41 +406,26 @@ void PrometheusHandler::number_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_number_value gauge\n"));
   stream->print(F("#TYPE esphome_number_failed gauge\n"));
 }
-void PrometheusHandler::number_row_(AsyncResponseStream *stream, number::Number *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
+void PrometheusHandler::number_row_(AsyncResponseStream *stream, number::Number *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_number_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_number_failed{"));
+    stream->print(labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_number_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_number_value{"));
+    stream->print(labels);
+    stream->print(F("} "));
     stream->print(obj->state);
     stream->print(F("\n"));
   } else {
     // Invalid state
-    stream->print(F("esphome_number_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_number_failed{"));
+    stream->print(labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -591,43 +435,28 @@ void PrometheusHandler::select_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_select_value gauge\n"));
   stream->print(F("#TYPE esphome_select_failed gauge\n"));
 }
-void PrometheusHandler::select_row_(AsyncResponseStream *stream, select::Select *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
+void PrometheusHandler::select_row_(AsyncResponseStream *stream, select::Select *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_select_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_select_failed{"));
+    stream->print(labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_select_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",value=\""));
+    stream->print(F("esphome_select_value{"));
+    stream->print(labels);
+    stream->print(F(",value=\""));
     stream->print(obj->state.c_str());
     stream->print(F("\"} "));
     stream->print(F("1.0"));
     stream->print(F("\n"));
   } else {
     // Invalid state
-    stream->print(F("esphome_select_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_select_failed{"));
+    stream->print(labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -639,49 +468,29 @@ void PrometheusHandler::media_player_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_media_player_is_muted gauge\n"));
   stream->print(F("#TYPE esphome_media_player_failed gauge\n"));
 }
-void PrometheusHandler::media_player_row_(AsyncResponseStream *stream, media_player::MediaPlayer *obj,
-                                          std::string &area, std::string &node, std::string &friendly_name) {
+void PrometheusHandler::media_player_row_(AsyncResponseStream *stream, media_player::MediaPlayer *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_media_player_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  const char *labels = this->entity_labels_(obj);
+  stream->print(F("esphome_media_player_failed{"));
+  stream->print(labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_media_player_state_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",value=\""));
+  stream->print(F("esphome_media_player_state_value{"));
+  stream->print(labels);
+  stream->print(F(",value=\""));
   stream->print(media_player::media_player_state_to_string(obj->state));
   stream->print(F("\"} "));
   stream->print(F("1.0"));
   stream->print(F("\n"));
-  stream->print(F("esphome_media_player_volume{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_media_player_volume{"));
+  stream->print(labels);
+  stream->print(F("} "));
   stream->print(obj->volume);
   stream->print(F("\n"));
-  stream->print(F("esphome_media_player_is_muted{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_media_player_is_muted{"));
+  stream->print(labels);
+  stream->print(F("} "));
   if (obj->is_muted()) {
     stream->print(F("1.0"));
   } else {
@@ -718,42 +527,27 @@ void PrometheusHandler::handle_update_state_(AsyncResponseStream *stream, update
   }
 }
 
-void PrometheusHandler::update_entity_row_(AsyncResponseStream *stream, update::UpdateEntity *obj, std::string &area,
-                                           std::string &node, std::string &friendly_name) {
+void PrometheusHandler::update_entity_row_(AsyncResponseStream *stream, update::UpdateEntity *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
+  const char *labels = this->entity_labels_(obj);
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_update_entity_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_update_entity_failed{"));
+    stream->print(labels);
+    stream->print(F("} 0\n"));
     // First update state
-    stream->print(F("esphome_update_entity_state{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",value=\""));
+    stream->print(F("esphome_update_entity_state{"));
+    stream->print(labels);
+    stream->print(F(",value=\""));
     handle_update_state_(stream, obj->state);
     stream->print(F("\"} "));
     stream->print(F("1.0"));
     stream->print(F("\n"));
     // Next update info
-    stream->print(F("esphome_update_entity_info{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",current_version=\""));
+    stream->print(F("esphome_update_entity_info{"));
+    stream->print(labels);
+    stream->print(F(",current_version=\""));
     stream->print(obj->update_info.current_version.c_str());
     stream->print(F("\",latest_version=\""));
     stream->print(obj->update_info.latest_version.c_str());
@@ -764,14 +558,9 @@ void PrometheusHandler::update_entity_row_(AsyncResponseStream *stream, update::
     stream->print(F("\n"));
   } else {
     // Invalid state
-    stream->print(F("esphome_update_entity_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_update_entity_failed{"));
+    stream->print(labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -783,41 +572,26 @@ void PrometheusHandler::valve_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_valve_position gauge\n"));
 }
 
-void PrometheusHandler::valve_row_(AsyncResponseStream *stream, valve::Valve *obj, std::string &area, std::string &node,
-                                   std::string &friendly_name) {
+void PrometheusHandler::valve_row_(AsyncResponseStream *stream, valve::Valve *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_valve_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  const char *labels = this->entity_labels_(obj);
+  stream->print(F("esphome_valve_failed{"));
+  stream->print(labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_valve_operation{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",operation=\""));
+  stream->print(F("esphome_valve_operation{"));
+  stream->print(labels);
+  stream->print(F(",operation=\""));
   stream->print(valve::valve_operation_to_str(obj->current_operation));
   stream->print(F("\"} "));
   stream->print(F("1.0"));
   stream->print(F("\n"));
   // Now see if position is supported
   if (obj->get_traits().get_supports_position()) {
-    stream->print(F("esphome_valve_position{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_valve_position{"));
+    stream->print(labels);
+    stream->print(F("} "));
     stream->print(obj->position);
     stream->print(F("\n"));
   }
@@ -3,6 +3,7 @@
 #ifdef USE_NETWORK
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/component.h"
@@ -60,104 +61,91 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
  protected:
   std::string relabel_id_(EntityBase *obj);
   std::string relabel_name_(EntityBase *obj);
-  void add_area_label_(AsyncResponseStream *stream, std::string &area);
-  void add_node_label_(AsyncResponseStream *stream, std::string &node);
-  void add_friendly_name_label_(AsyncResponseStream *stream, std::string &friendly_name);
+  /// Return the labels of the next exported entity, `id="...",...,name="..."`, built on the first scrape.
+  const char *entity_labels_(EntityBase *obj);
 
 #ifdef USE_SENSOR
   /// Return the type for prometheus
   void sensor_type_(AsyncResponseStream *stream);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   /// Return the type for prometheus
   void binary_sensor_type_(AsyncResponseStream *stream);
   /// Return the binary sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj, std::string &area,
-                          std::string &node, std::string &friendly_name);
+  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj);
 #endif
 
 #ifdef USE_FAN
   /// Return the type for prometheus
   void fan_type_(AsyncResponseStream *stream);
   /// Return the fan state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj, std::string &area, std::string &node,
-                std::string &friendly_name);
+  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj);
 #endif
 
 #ifdef USE_LIGHT
   /// Return the type for prometheus
   void light_type_(AsyncResponseStream *stream);
   /// Return the light values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj, std::string &area, std::string &node,
-                  std::string &friendly_name);
+  void light_row_(AsyncResponseStream *stream, light::LightState *obj);
 #endif
 
 #ifdef USE_COVER
   /// Return the type for prometheus
   void cover_type_(AsyncResponseStream *stream);
   /// Return the cover values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj, std::string &area, std::string &node,
-                  std::string &friendly_name);
+  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj);
 #endif
 
 #ifdef USE_SWITCH
   /// Return the type for prometheus
   void switch_type_(AsyncResponseStream *stream);
   /// Return the switch values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
 #endif
 
 #ifdef USE_LOCK
   /// Return the type for prometheus
   void lock_type_(AsyncResponseStream *stream);
   /// Return the lock values state as prometheus data point
-  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj, std::string &area, std::string &node,
-                 std::string &friendly_name);
+  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj);
 #endif
 
 #ifdef USE_TEXT_SENSOR
   /// Return the type for prometheus
   void text_sensor_type_(AsyncResponseStream *stream);
   /// Return the text sensor values state as prometheus data point
-  void text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj, std::string &area, std::string &node,
-                        std::string &friendly_name);
+  void text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj);
 #endif
 
 #ifdef USE_NUMBER
   /// Return the type for prometheus
   void number_type_(AsyncResponseStream *stream);
   /// Return the number state as prometheus data point
-  void number_row_(AsyncResponseStream *stream, number::Number *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void number_row_(AsyncResponseStream *stream, number::Number *obj);
 #endif
 
 #ifdef USE_SELECT
   /// Return the type for prometheus
   void select_type_(AsyncResponseStream *stream);
   /// Return the select state as prometheus data point
-  void select_row_(AsyncResponseStream *stream, select::Select *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void select_row_(AsyncResponseStream *stream, select::Select *obj);
 #endif
 
 #ifdef USE_MEDIA_PLAYER
   /// Return the type for prometheus
   void media_player_type_(AsyncResponseStream *stream);
   /// Return the media player state as prometheus data point
-  void media_player_row_(AsyncResponseStream *stream, media_player::MediaPlayer *obj, std::string &area,
-                         std::string &node, std::string &friendly_name);
+  void media_player_row_(AsyncResponseStream *stream, media_player::MediaPlayer *obj);
 #endif
 
 #ifdef USE_UPDATE
   /// Return the type for prometheus
   void update_entity_type_(AsyncResponseStream *stream);
   /// Return the update state and info as prometheus data point
-  void update_entity_row_(AsyncResponseStream *stream, update::UpdateEntity *obj, std::string &area, std::string &node,
-                          std::string &friendly_name);
+  void update_entity_row_(AsyncResponseStream *stream, update::UpdateEntity *obj);
   void handle_update_state_(AsyncResponseStream *stream, update::UpdateState state);
 #endif
 
@@ -165,14 +153,22 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
   /// Return the type for prometheus
   void valve_type_(AsyncResponseStream *stream);
   /// Return the valve state as prometheus data point
-  void valve_row_(AsyncResponseStream *stream, valve::Valve *obj, std::string &area, std::string &node,
-                  std::string &friendly_name);
+  void valve_row_(AsyncResponseStream *stream, valve::Valve *obj);
 #endif
 
   web_server_base::WebServerBase *base_;
   bool include_internal_{false};
   std::map<EntityBase *, std::string> relabel_map_id_;
   std::map<EntityBase *, std::string> relabel_map_name_;
+
+  struct LabelEntry {
+    EntityBase *obj;
+    uint32_t offset;
+  };
+  /// Labels of all exported entities in scrape order, each terminated by a NUL.
+  std::string label_arena_;
+  std::vector<LabelEntry> label_entries_;
+  size_t label_cursor_{0};
 };
 
 }  // namespace prometheus
@@ -106,20 +106,30 @@ void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
   }
 }
 
+void RemoteReceiverBase::call_listeners_dumpers_() {
+  // unique across all receivers, skipping 0 which disables caching
+  static uint32_t last_burst_id = 0;
+  if (++last_burst_id == 0)
+    ++last_burst_id;
+  this->burst_id_ = last_burst_id;
+  this->call_listeners_();
+  this->call_dumpers_();
+}
+
 void RemoteReceiverBase::call_listeners_() {
   for (auto *listener : this->listeners_)
-    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
+    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, this->burst_id_));
 }
 
 void RemoteReceiverBase::call_dumpers_() {
   bool success = false;
   for (auto *dumper : this->dumpers_) {
-    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_)))
+    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, this->burst_id_)))
       success = true;
   }
   if (!success) {
     for (auto *dumper : this->secondary_dumpers_)
-      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
+      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, this->burst_id_));
   }
 }
 
@@ -47,11 +47,14 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode)
-      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode) {}
+  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode,
+                             uint32_t burst_id = 0)
+      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode), burst_id_(burst_id) {}
 
   const RawTimings &get_raw_data() const { return this->data_; }
   uint32_t get_index() const { return index_; }
+  /// Identifies the received burst these timings belong to, 0 if the decoded results must not be cached.
+  uint32_t get_burst_id() const { return this->burst_id_; }
   int32_t operator[](uint32_t index) const { return this->data_[index]; }
   int32_t size() const { return this->data_.size(); }
   bool is_valid(uint32_t offset = 0) const { return this->index_ + offset < this->data_.size(); }
@@ -99,6 +102,7 @@ class RemoteReceiveData {
   uint32_t index_;
   uint32_t tolerance_;
   ToleranceMode tolerance_mode_;
+  uint32_t burst_id_;
 };
 
 class RemoteComponentBase {
@@ -215,15 +219,14 @@ class RemoteReceiverBase : public RemoteComponentBase {
  protected:
   void call_listeners_();
   void call_dumpers_();
-  void call_listeners_dumpers_() {
-    this->call_listeners_();
-    this->call_dumpers_();
-  }
+  void call_listeners_dumpers_();
 
   std::vector<RemoteReceiverListener *> listeners_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   RawTimings temp_;
+  /// Id of the burst in temp_, protocols decode each burst only once for all listeners and dumpers.
+  uint32_t burst_id_{0};
   uint32_t tolerance_{25};
   ToleranceMode tolerance_mode_{TOLERANCE_MODE_PERCENTAGE};
 };
@@ -248,14 +251,37 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const ProtocolData &data) = 0;
 };
 
+/** Decode a received burst with protocol T at most once.
+ *
+ * Listeners and dumpers of the same protocol all get the result of the first decode of the burst, so a config
+ * with many buttons of one protocol doesn't decode the same timings over and over again.
+ */
+template<typename T> class RemoteDecodeCache {
+ public:
+  static optional<typename T::ProtocolData> decode(RemoteReceiveData src) {
+    if (src.get_burst_id() == 0 || src.get_index() != 0)
+      return T().decode(src);
+    if (burst_id_ != src.get_burst_id()) {
+      result_ = T().decode(src);
+      burst_id_ = src.get_burst_id();
+    }
+    return result_;
+  }
+
+ protected:
+  static uint32_t burst_id_;                         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static optional<typename T::ProtocolData> result_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+};
+template<typename T> uint32_t RemoteDecodeCache<T>::burst_id_{0};                         // NOLINT
+template<typename T> optional<typename T::ProtocolData> RemoteDecodeCache<T>::result_{};  // NOLINT
+
 template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = RemoteDecodeCache<T>::decode(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -270,8 +296,7 @@ template<typename T>
 class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = RemoteDecodeCache<T>::decode(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -312,11 +337,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public RemoteTransm
 template<typename T> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    auto decoded = RemoteDecodeCache<T>::decode(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
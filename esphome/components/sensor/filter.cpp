@@ -1,4 +1,5 @@
 #include "filter.h"
+#include <algorithm>
 #include <cmath>
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -31,49 +32,90 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
-// MedianFilter
-MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MedianFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
+// SlidingWindowFilter
+SlidingWindowFilter::SlidingWindowFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : window_(std::max<size_t>(window_size, 1)),
+      window_size_(std::max<size_t>(window_size, 1)),
+      send_every_(send_every),
+      send_at_(send_every - send_first_at) {}
+void SlidingWindowFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
+void SlidingWindowFilter::set_window_size(size_t window_size) {
+  // the window always holds at least the newest value
+  window_size = std::max<size_t>(window_size, 1);
+  // Keep the most recent values that fit in the new window
+  const size_t count = std::min(this->window_count_, window_size);
+  std::vector<float> window(window_size);
+  for (size_t i = 0; i < count; i++)
+    window[i] = this->window_[(this->window_head_ + this->window_count_ - count + i) % this->window_size_];
+  this->window_ = std::move(window);
+  this->window_size_ = window_size;
+  this->window_head_ = 0;
+  this->window_count_ = count;
+  this->clear_();
+  for (size_t i = 0; i < count; i++)
+    this->push_(i);
+}
+optional<float> SlidingWindowFilter::new_value(float value) {
+  if (this->window_count_ == this->window_size_) {
+    this->evict_(this->window_head_);
+    if (++this->window_head_ == this->window_size_)
+      this->window_head_ = 0;
+    this->window_count_--;
   }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
+  size_t pos = this->window_head_ + this->window_count_;
+  if (pos >= this->window_size_)
+    pos -= this->window_size_;
+  this->window_[pos] = value;
+  this->window_count_++;
+  this->push_(pos);
+  ESP_LOGVV(TAG, "%s(%p)::new_value(%f)", this->get_log_name_(), this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
-
-    float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
-      }
-    }
-
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f) SENDING %f", this, value, median);
-    return median;
+    float result = this->compute_();
+    ESP_LOGVV(TAG, "%s(%p)::new_value(%f) SENDING %f", this->get_log_name_(), this, value, result);
+    return result;
   }
   return {};
 }
 
+// SortedWindowFilter
+SortedWindowFilter::SortedWindowFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : SlidingWindowFilter(window_size, send_every, send_first_at) {
+  this->sorted_.reserve(this->window_size_);
+}
+void SortedWindowFilter::push_(size_t pos) {
+  const float value = this->window_[pos];
+  // NaN values take up a place in the window, but are left out of the result
+  if (std::isnan(value))
+    return;
+  this->sorted_.insert(std::upper_bound(this->sorted_.begin(), this->sorted_.end(), value), value);
+}
+void SortedWindowFilter::evict_(size_t pos) {
+  const float value = this->window_[pos];
+  if (std::isnan(value))
+    return;
+  auto it = std::lower_bound(this->sorted_.begin(), this->sorted_.end(), value);
+  if (it != this->sorted_.end())
+    this->sorted_.erase(it);
+}
+void SortedWindowFilter::clear_() {
+  this->sorted_.clear();
+  this->sorted_.reserve(this->window_size_);
+}
+
+// MedianFilter
+MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : SortedWindowFilter(window_size, send_every, send_first_at) {}
+float MedianFilter::compute_() {
+  const size_t size = this->sorted_.size();
+  if (size == 0)
+    return NAN;
+  if (size % 2)
+    return this->sorted_[size / 2];
+  return (this->sorted_[size / 2] + this->sorted_[(size / 2) - 1]) / 2.0f;
+}
+
 // SkipInitialFilter
 SkipInitialFilter::SkipInitialFilter(size_t num_to_ignore) : num_to_ignore_(num_to_ignore) {}
 optional<float> SkipInitialFilter::new_value(float value) {
@@ -89,101 +131,70 @@ optional<float> SkipInitialFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
-void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+    : SortedWindowFilter(window_size, send_every, send_first_at), quantile_(quantile) {}
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
-optional<float> QuantileFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
-    }
+float QuantileFilter::compute_() {
+  const size_t size = this->sorted_.size();
+  if (size == 0)
+    return NAN;
+  const float rank = ceilf(size * this->quantile_);
+  size_t position = rank < 1.0f ? 0 : std::min(static_cast<size_t>(rank) - 1, size - 1);
+  ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %zu/%zu", this, position + 1, size);
+  return this->sorted_[position];
+}
 
-    ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
-    return result;
+// MonotonicWindowFilter
+MonotonicWindowFilter::MonotonicWindowFilter(size_t window_size, size_t send_every, size_t send_first_at,
+                                             bool find_max)
+    : SlidingWindowFilter(window_size, send_every, send_first_at),
+      candidates_(this->window_size_),
+      find_max_(find_max) {}
+void MonotonicWindowFilter::push_(size_t pos) {
+  const float value = this->window_[pos];
+  if (std::isnan(value))
+    return;
+  // Older values that are not better than the new one can never be the result again
+  while (this->candidates_count_ > 0) {
+    size_t back = this->candidates_head_ + this->candidates_count_ - 1;
+    if (back >= this->window_size_)
+      back -= this->window_size_;
+    const float other = this->window_[this->candidates_[back]];
+    if (this->find_max_ ? other > value : other < value)
+      break;
+    this->candidates_count_--;
   }
-  return {};
+  size_t back = this->candidates_head_ + this->candidates_count_;
+  if (back >= this->window_size_)
+    back -= this->window_size_;
+  this->candidates_[back] = pos;
+  this->candidates_count_++;
+}
+void MonotonicWindowFilter::evict_(size_t pos) {
+  // Only the oldest candidate can be the value leaving the window
+  if (this->candidates_count_ == 0 || this->candidates_[this->candidates_head_] != pos)
+    return;
+  if (++this->candidates_head_ == this->window_size_)
+    this->candidates_head_ = 0;
+  this->candidates_count_--;
+}
+void MonotonicWindowFilter::clear_() {
+  this->candidates_.assign(this->window_size_, 0);
+  this->candidates_head_ = 0;
+  this->candidates_count_ = 0;
+}
+float MonotonicWindowFilter::compute_() {
+  if (this->candidates_count_ == 0)
+    return NAN;
+  return this->window_[this->candidates_[this->candidates_head_]];
 }
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
-
-    ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
-    return min;
-  }
-  return {};
-}
+    : MonotonicWindowFilter(window_size, send_every, send_first_at, false) {}
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
-
-    ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
-    return max;
-  }
-  return {};
-}
+    : MonotonicWindowFilter(window_size, send_every, send_first_at, true) {}
 
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
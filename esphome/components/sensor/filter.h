@@ -44,11 +44,86 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
+/** Base class for filters that compute a result over the last <window_size> values.
+ *
+ * The values are kept in a ring buffer allocated once for the window size. Subclasses keep whatever
+ * additional structure they need up to date through push_() and evict_(), so that computing a result
+ * doesn't have to walk the whole window.
+ */
+class SlidingWindowFilter : public Filter {
+ public:
+  SlidingWindowFilter(size_t window_size, size_t send_every, size_t send_first_at);
+
+  optional<float> new_value(float value) override;
+
+  void set_send_every(size_t send_every);
+  void set_window_size(size_t window_size);
+
+ protected:
+  /// Called after the value at ring position pos was added to the window.
+  virtual void push_(size_t pos) = 0;
+  /// Called before the value at ring position pos drops out of the window.
+  virtual void evict_(size_t pos) = 0;
+  /// Forget all values and size the structures for window_size_, the window is refilled with push_() afterwards.
+  virtual void clear_() = 0;
+  /// Compute the value to send from the values currently in the window.
+  virtual float compute_() = 0;
+  /// Name of the concrete filter for log messages.
+  virtual const char *get_log_name_() const = 0;
+
+  std::vector<float> window_;
+  size_t window_size_;
+  /// Ring position of the oldest value.
+  size_t window_head_{0};
+  size_t window_count_{0};
+  size_t send_every_;
+  size_t send_at_;
+};
+
+/** Base class for filters that need the non-NaN values of the window in sorted order.
+ *
+ * Insertion and eviction binary search their position in a vector that is reserved for the whole window, so
+ * updates only move contiguous floats and never allocate.
+ */
+class SortedWindowFilter : public SlidingWindowFilter {
+ public:
+  SortedWindowFilter(size_t window_size, size_t send_every, size_t send_first_at);
+
+ protected:
+  void push_(size_t pos) override;
+  void evict_(size_t pos) override;
+  void clear_() override;
+
+  std::vector<float> sorted_;
+};
+
+/** Base class for the min and max filters.
+ *
+ * Keeps a monotonic queue of the ring positions of the values that can still become the extremum of the window,
+ * so the result is always at its front.
+ */
+class MonotonicWindowFilter : public SlidingWindowFilter {
+ public:
+  MonotonicWindowFilter(size_t window_size, size_t send_every, size_t send_first_at, bool find_max);
+
+ protected:
+  void push_(size_t pos) override;
+  void evict_(size_t pos) override;
+  void clear_() override;
+  float compute_() override;
+  const char *get_log_name_() const override { return this->find_max_ ? "MaxFilter" : "MinFilter"; }
+
+  std::vector<size_t> candidates_;
+  size_t candidates_head_{0};
+  size_t candidates_count_{0};
+  bool find_max_;
+};
+
 /** Simple quantile filter.
  *
  * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
  */
-class QuantileFilter : public Filter {
+class QuantileFilter : public SortedWindowFilter {
  public:
   /** Construct a QuantileFilter.
    *
@@ -61,17 +136,12 @@ class QuantileFilter : public Filter {
    */
   explicit QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile);
 
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
+  float compute_() override;
+  const char *get_log_name_() const override { return "QuantileFilter"; }
+
   float quantile_;
 };
 
@@ -79,7 +149,7 @@ class QuantileFilter : public Filter {
  *
  * Takes the median of the last <send_every> values and pushes it out every <send_every>.
  */
-class MedianFilter : public Filter {
+class MedianFilter : public SortedWindowFilter {
  public:
   /** Construct a MedianFilter.
    *
@@ -91,16 +161,9 @@ class MedianFilter : public Filter {
    */
   explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
  protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
+  float compute_() override;
+  const char *get_log_name_() const override { return "MedianFilter"; }
 };
 
 /** Simple skip filter.
@@ -125,7 +188,7 @@ class SkipInitialFilter : public Filter {
  *
  * Takes the min of the last <send_every> values and pushes it out every <send_every>.
  */
-class MinFilter : public Filter {
+class MinFilter : public MonotonicWindowFilter {
  public:
   /** Construct a MinFilter.
    *
@@ -136,24 +199,13 @@ class MinFilter : public Filter {
    *   send_every.
    */
   explicit MinFilter(size_t window_size, size_t send_every, size_t send_first_at);
-
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
- protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
  *
  * Takes the max of the last <send_every> values and pushes it out every <send_every>.
  */
-class MaxFilter : public Filter {
+class MaxFilter : public MonotonicWindowFilter {
  public:
   /** Construct a MaxFilter.
    *
@@ -164,17 +216,6 @@ class MaxFilter : public Filter {
    *   send_every.
    */
   explicit MaxFilter(size_t window_size, size_t send_every, size_t send_first_at);
-
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
- protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -238,6 +238,16 @@ class SPIDelegate {
       this->transfer(ptr[i]);
   }
 
+  /**
+   * Start writing the contents of a buffer without waiting for the transfer to complete. At most one such write is
+   * in flight at a time, starting the next one waits for the previous one. The buffer must stay unchanged until the
+   * next write_array_async() or wait_for_writes() call has returned. The default implementation writes synchronously.
+   */
+  virtual void write_array_async(const uint8_t *ptr, size_t length) { this->write_array(ptr, length); }
+
+  // wait for a write started with write_array_async() to complete.
+  virtual void wait_for_writes() {}
+
   // read into a buffer, write nulls
   virtual void read_array(uint8_t *ptr, size_t length) {
     for (size_t i = 0; i != length; i++)
@@ -485,6 +495,15 @@ class SPIDevice : public SPIClient {
 
   void write_array(const uint8_t *data, size_t length) { this->delegate_->write_array(data, length); }
 
+  /**
+   * Start writing the array data without waiting for the transfer to complete, see SPIDelegate::write_array_async().
+   * The data must stay unchanged until the next write_array_async() or wait_for_writes() call has returned.
+   * Ending the transaction waits for the write to complete.
+   */
+  void write_array_async(const uint8_t *data, size_t length) { this->delegate_->write_array_async(data, length); }
+
+  void wait_for_writes() { this->delegate_->wait_for_writes(); }
+
   template<size_t N> void write_array(const std::array<uint8_t, N> &data) { this->write_array(data.data(), N); }
 
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
@@ -44,12 +44,14 @@ class SPIDelegateHw : public SPIDelegate {
 
   void end_transaction() override {
     if (this->is_ready()) {
+      this->wait_for_writes();
       SPIDelegate::end_transaction();
       spi_device_release_bus(this->handle_);
     }
   }
 
   ~SPIDelegateHw() override {
+    this->wait_for_writes();
     esp_err_t const err = spi_bus_remove_device(this->handle_);
     if (err != ESP_OK)
       ESP_LOGE(TAG, "Remove device failed - err %X", err);
@@ -64,6 +66,8 @@ class SPIDelegateHw : public SPIDelegate {
       ESP_LOGE(TAG, "Attempted read from write-only channel");
       return;
     }
+    // polling transfers can't be mixed with a queued one that is still in flight
+    this->wait_for_writes();
     spi_transaction_t desc = {};
     desc.flags = 0;
     while (length != 0) {
@@ -90,6 +94,7 @@ class SPIDelegateHw : public SPIDelegate {
   }
 
   void write(uint16_t data, size_t num_bits) override {
+    this->wait_for_writes();
     spi_transaction_ext_t desc = {};
     desc.command_bits = num_bits;
     desc.base.flags = SPI_TRANS_VARIABLE_CMD;
@@ -121,6 +126,7 @@ class SPIDelegateHw : public SPIDelegate {
       esph_log_w(TAG, "Nothing to transfer");
       return;
     }
+    this->wait_for_writes();
     desc.base.flags = SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_DUMMY;
     if (bus_width == 4) {
       desc.base.flags |= SPI_TRANS_MODE_QIO;
@@ -170,6 +176,35 @@ class SPIDelegateHw : public SPIDelegate {
 
   void write_array(const uint8_t *ptr, size_t length) override { this->transfer(ptr, nullptr, length); }
 
+  // queue an interrupt transfer, so the caller can prepare the next block while this one is sent.
+  void write_array_async(const uint8_t *ptr, size_t length) override {
+    while (length != 0) {
+      this->wait_for_writes();
+      size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+      this->async_desc_ = {};
+      this->async_desc_.length = partial * 8;
+      this->async_desc_.tx_buffer = ptr;
+      esp_err_t const err = spi_device_queue_trans(this->handle_, &this->async_desc_, portMAX_DELAY);
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Transmit failed - err %X", err);
+        return;
+      }
+      this->async_pending_ = true;
+      length -= partial;
+      ptr += partial;
+    }
+  }
+
+  void wait_for_writes() override {
+    if (!this->async_pending_)
+      return;
+    this->async_pending_ = false;
+    spi_transaction_t *desc;
+    esp_err_t const err = spi_device_get_trans_result(this->handle_, &desc, portMAX_DELAY);
+    if (err != ESP_OK)
+      ESP_LOGE(TAG, "Transmit failed - err %X", err);
+  }
+
   void write_array16(const uint16_t *data, size_t length) override {
     if (this->bit_order_ == BIT_ORDER_LSB_FIRST) {
       this->write_array((uint8_t *) data, length * 2);
@@ -192,6 +227,9 @@ class SPIDelegateHw : public SPIDelegate {
   SPIInterface channel_{};
   spi_device_handle_t handle_{};
   bool write_only_{false};
+  // descriptor of the queued transfer started by write_array_async()
+  spi_transaction_t async_desc_{};
+  bool async_pending_{false};
 };
 
 class SPIBusHw : public SPIBus {
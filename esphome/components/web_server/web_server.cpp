@@ -1,6 +1,7 @@
 #include "web_server.h"
 #ifdef USE_WEBSERVER
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
 #include "esphome/core/entity_base.h"
@@ -87,15 +88,24 @@ void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_
 #endif
 
 std::string WebServer::get_config_json() {
-  return json::build_json([this](JsonObject root) {
-    root["title"] = App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name();
-    root["comment"] = App.get_comment();
-    root["ota"] = this->allow_ota_;
-    root["log"] = this->expose_log_;
-    root["lang"] = "en";
+  return json::write_json([this](json::JsonWriter &writer) {
+    writer.member("title", App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name());
+    writer.member("comment", App.get_comment());
+    writer.member("ota", this->allow_ota_);
+    writer.member("log", this->expose_log_);
+    writer.member("lang", "en");
   });
 }
 
+void WebServer::send_state_event_(EntityBase *obj, const std::string &data) {
+#ifdef USE_ESP_IDF
+  // A queued state of the same entity that a slow client hasn't received yet is superseded by this one
+  this->events_.send(data.c_str(), "state", 0, 0, obj);
+#else
+  this->events_.send(data.c_str(), "state");
+#endif
+}
+
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
   this->setup_controller(this->include_internal_);
@@ -146,6 +156,9 @@ void WebServer::loop() {
       fn();
     }
   }
+#endif
+#ifdef USE_ESP_IDF
+  this->events_.loop();
 #endif
   this->entities_iterator_.advance();
 }
@@ -209,6 +222,30 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
       (root)["is_disabled_by_default"] = (obj)->is_disabled_by_default(); \
   }
 
+/// JsonSink writing straight into the body of a response.
+class ResponseStreamJsonSink : public json::JsonSink {
+ public:
+  explicit ResponseStreamJsonSink(AsyncResponseStream *stream) : stream_(stream) {}
+  void write(const char *data, size_t len) override {
+    this->stream_->write(reinterpret_cast<const uint8_t *>(data), len);
+  }
+
+ protected:
+  AsyncResponseStream *stream_;
+};
+
+/// Same as set_json_id, for a JsonWriter.
+static void write_json_id(json::JsonWriter &writer, EntityBase *obj, const std::string &id, JsonDetail start_config) {
+  writer.member("id", id);
+  if (start_config == DETAIL_ALL) {
+    writer.member("name", obj->get_name());
+    writer.member("icon", obj->get_icon());
+    writer.member("entity_category", static_cast<uint8_t>(obj->get_entity_category()));
+    if (obj->is_disabled_by_default())
+      writer.member("is_disabled_by_default", true);
+  }
+}
+
 #define set_json_value(root, obj, sensor, value, start_config) \
   set_json_id((root), (obj), sensor, start_config); \
   (root)["value"] = value;
@@ -221,7 +258,7 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->sensor_json(obj, state, DETAIL_STATE));
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
@@ -269,7 +306,7 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->text_sensor_json(obj, state, DETAIL_STATE));
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
@@ -308,7 +345,7 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->switch_json(obj, state, DETAIL_STATE));
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (switch_::Switch *obj : App.get_switches()) {
@@ -398,7 +435,7 @@ std::string WebServer::button_json(button::Button *obj, JsonDetail start_config)
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->binary_sensor_json(obj, state, DETAIL_STATE));
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
@@ -437,7 +474,7 @@ std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool
 void WebServer::on_fan_update(fan::Fan *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->fan_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (fan::Fan *obj : App.get_fans()) {
@@ -521,7 +558,10 @@ std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
 void WebServer::on_light_update(light::LightState *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
+  json::write_json(this->event_buffer_, [this, obj](json::JsonWriter &writer) {
+    this->write_light_json_(writer, obj, DETAIL_STATE);
+  });
+  this->send_state_event_(obj, this->event_buffer_);
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
@@ -534,8 +574,13 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
       if (param && param->value() == "all") {
         detail = DETAIL_ALL;
       }
-      std::string data = this->light_json(obj, detail);
-      request->send(200, "application/json", data.c_str());
+      auto *stream = request->beginResponseStream("application/json");
+      ResponseStreamJsonSink sink(stream);
+      json::JsonWriter writer(sink);
+      writer.begin_object();
+      this->write_light_json_(writer, obj, detail);
+      writer.end_object();
+      request->send(stream);
     } else if (match.method == "toggle") {
       this->schedule_([obj]() { obj->toggle().perform(); });
       request->send(200);
@@ -614,25 +659,30 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
-    root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
+  return json::write_json(
+      [this, obj, start_config](json::JsonWriter &writer) { this->write_light_json_(writer, obj, start_config); });
+}
+void WebServer::write_light_json_(json::JsonWriter &writer, light::LightState *obj, JsonDetail start_config) {
+  write_json_id(writer, obj, "light-" + obj->get_object_id(), start_config);
+  // dump_json() only writes the state for color modes that have one
+  if (!(obj->remote_values.get_color_mode() & light::ColorCapability::ON_OFF))
+    writer.member("state", obj->remote_values.is_on() ? "ON" : "OFF");
 
-    light::LightJSONSchema::dump_json(*obj, root);
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("effects");
-      opt.add("None");
-      for (auto const &option : obj->get_effects()) {
-        opt.add(option->get_name());
-      }
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  light::LightJSONSchema::dump_json(*obj, writer);
+  if (start_config == DETAIL_ALL) {
+    writer.begin_array("effects");
+    writer.value("None");
+    for (auto const &option : obj->get_effects()) {
+      writer.value(option->get_name());
+    }
+    writer.end_array();
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      writer.member("sorting_weight", this->sorting_entitys_[obj].weight);
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        writer.member("sorting_group", this->sorting_groups_[this->sorting_entitys_[obj].group_id].name);
       }
     }
-  });
+  }
 }
 #endif
 
@@ -640,7 +690,7 @@ std::string WebServer::light_json(light::LightState *obj, JsonDetail start_confi
 void WebServer::on_cover_update(cover::Cover *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->cover_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
@@ -724,7 +774,7 @@ std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
 void WebServer::on_number_update(number::Number *obj, float state) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->number_json(obj, state, DETAIL_STATE));
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_numbers()) {
@@ -798,7 +848,7 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
 void WebServer::on_date_update(datetime::DateEntity *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->date_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->date_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_date_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_dates()) {
@@ -860,7 +910,7 @@ std::string WebServer::date_json(datetime::DateEntity *obj, JsonDetail start_con
 void WebServer::on_time_update(datetime::TimeEntity *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->time_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->time_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_time_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_times()) {
@@ -921,7 +971,7 @@ std::string WebServer::time_json(datetime::TimeEntity *obj, JsonDetail start_con
 void WebServer::on_datetime_update(datetime::DateTimeEntity *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->datetime_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->datetime_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_datetime_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_datetimes()) {
@@ -983,7 +1033,7 @@ std::string WebServer::datetime_json(datetime::DateTimeEntity *obj, JsonDetail s
 void WebServer::on_text_update(text::Text *obj, const std::string &state) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->text_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->text_json(obj, state, DETAIL_STATE));
 }
 void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_texts()) {
@@ -1047,7 +1097,7 @@ std::string WebServer::text_json(text::Text *obj, const std::string &value, Json
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->select_json(obj, state, DETAIL_STATE));
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_selects()) {
@@ -1109,7 +1159,7 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 void WebServer::on_climate_update(climate::Climate *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->climate_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_climates()) {
@@ -1270,7 +1320,7 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
 void WebServer::on_lock_update(lock::Lock *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->lock_json(obj, obj->state, DETAIL_STATE));
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (lock::Lock *obj : App.get_locks()) {
@@ -1321,7 +1371,7 @@ std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDet
 void WebServer::on_valve_update(valve::Valve *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->valve_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->valve_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_valve_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (valve::Valve *obj : App.get_valves()) {
@@ -1396,7 +1446,7 @@ std::string WebServer::valve_json(valve::Valve *obj, JsonDetail start_config) {
 void WebServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE));
 }
 void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (alarm_control_panel::AlarmControlPanel *obj : App.get_alarm_control_panels()) {
@@ -1508,7 +1558,7 @@ std::string WebServer::event_json(event::Event *obj, const std::string &event_ty
 void WebServer::on_update(update::UpdateEntity *obj) {
   if (this->events_.count() == 0)
     return;
-  this->events_.send(this->update_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, this->update_json(obj, DETAIL_STATE));
 }
 void WebServer::handle_update_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (update::UpdateEntity *obj : App.get_updates()) {
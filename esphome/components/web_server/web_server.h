@@ -4,6 +4,7 @@
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #ifdef USE_WEBSERVER
+#include "esphome/components/json/json_writer.h"
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/entity_base.h"
@@ -351,9 +352,17 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   void schedule_(std::function<void()> &&f);
+  /// Send the state of an entity to the event stream clients.
+  void send_state_event_(EntityBase *obj, const std::string &data);
+#ifdef USE_LIGHT
+  /// Write the members of the light state JSON object.
+  void write_light_json_(json::JsonWriter &writer, light::LightState *obj, JsonDetail start_config);
+#endif
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
+  /// State event JSON written with a JsonWriter, reused between events.
+  std::string event_buffer_;
   ListEntitiesIterator entities_iterator_;
   std::map<EntityBase *, SortingComponents> sorting_entitys_;
   std::map<uint64_t, SortingGroup> sorting_groups_;
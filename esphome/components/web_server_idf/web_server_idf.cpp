@@ -1,6 +1,8 @@
 #ifdef USE_ESP_IDF
 
+#include <cerrno>
 #include <cstdarg>
+#include <sys/socket.h>
 
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
@@ -22,6 +24,9 @@ namespace web_server_idf {
 
 static const char *const TAG = "web_server_idf";
 
+/// Close reason of an event session whose queue overflowed, send errors are reported as positive errno values.
+static const int EVENT_QUEUE_FULL = -1;
+
 void AsyncWebServer::end() {
   if (this->server_) {
     httpd_stop(this->server_);
@@ -148,6 +153,13 @@ std::string AsyncWebServerRequest::url() const {
 std::string AsyncWebServerRequest::host() const { return this->get_header("Host").value(); }
 
 void AsyncWebServerRequest::send(AsyncWebServerResponse *response) {
+  if (response->is_chunked()) {
+    // send the rest and terminate the chunked response
+    if (response->get_content_size() > 0)
+      httpd_resp_send_chunk(*this, response->get_content_data(), response->get_content_size());
+    httpd_resp_send_chunk(*this, nullptr, 0);
+    return;
+  }
   httpd_resp_send(*this, response->get_content_data(), response->get_content_size());
 }
 
@@ -247,11 +259,23 @@ AsyncWebParameter *AsyncWebServerRequest::getParam(const std::string &name) {
 }
 
 void AsyncWebServerResponse::addHeader(const char *name, const char *value) {
+  if (this->is_chunked()) {
+    ESP_LOGW(TAG, "Header %s ignored, the response headers were already sent", name);
+    return;
+  }
   httpd_resp_set_hdr(*this->req_, name, value);
 }
 
 void AsyncResponseStream::print(float value) { this->print(to_string(value)); }
 
+void AsyncResponseStream::send_chunk_() {
+  // once the client is gone only the buffer has to be kept from growing
+  if (!this->failed_ && httpd_resp_send_chunk(*this->req_, this->content_.data(), this->content_.size()) != ESP_OK)
+    this->failed_ = true;
+  this->chunked_ = true;
+  this->content_.clear();
+}
+
 void AsyncResponseStream::printf(const char *fmt, ...) {
   va_list args;
 
@@ -280,13 +304,97 @@ void AsyncEventSource::handleRequest(AsyncWebServerRequest *request) {
   if (this->on_connect_) {
     this->on_connect_(rsp);
   }
+  LockGuard guard(this->sessions_lock_);
   this->sessions_.insert(rsp);
 }
 
-void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
-  for (auto *ses : this->sessions_) {
-    ses->send(message, event, id, reconnect);
+size_t AsyncEventSource::count() const {
+  LockGuard guard(this->sessions_lock_);
+  return this->sessions_.size();
+}
+
+void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect,
+                            const void *key) {
+  int closed_fd = 0;
+  int closed_reason = 0;
+  {
+    LockGuard guard(this->sessions_lock_);
+    if (this->sessions_.empty())
+      return;
+    auto chunk = format_chunk_(message, event, id, reconnect);
+    if (chunk == nullptr)
+      return;
+    for (auto *ses : this->sessions_) {
+      const int fd = ses->fd_;
+      const int reason = ses->enqueue_(chunk, key);
+      if (reason != 0) {
+        closed_fd = fd;
+        closed_reason = reason;
+      }
+    }
+  }
+  if (closed_reason != 0)
+    AsyncEventSourceResponse::log_closed_(closed_fd, closed_reason);
+}
+
+void AsyncEventSource::loop() {
+  int closed_fd = 0;
+  int closed_reason = 0;
+  {
+    LockGuard guard(this->sessions_lock_);
+    for (auto *ses : this->sessions_) {
+      const int fd = ses->fd_;
+      const int reason = ses->flush_();
+      if (reason != 0) {
+        closed_fd = fd;
+        closed_reason = reason;
+      }
+    }
+  }
+  if (closed_reason != 0)
+    AsyncEventSourceResponse::log_closed_(closed_fd, closed_reason);
+}
+
+std::shared_ptr<const std::string> AsyncEventSource::format_chunk_(const char *message, const char *event,
+                                                                   uint32_t id, uint32_t reconnect) {
+  std::string ev;
+
+  if (reconnect) {
+    ev.append("retry: ", sizeof("retry: ") - 1);
+    ev.append(to_string(reconnect));
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (id) {
+    ev.append("id: ", sizeof("id: ") - 1);
+    ev.append(to_string(id));
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (event && *event) {
+    ev.append("event: ", sizeof("event: ") - 1);
+    ev.append(event);
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (message && *message) {
+    ev.append("data: ", sizeof("data: ") - 1);
+    ev.append(message);
+    ev.append(CRLF_STR, CRLF_LEN);
   }
+
+  if (ev.empty()) {
+    return nullptr;
+  }
+
+  ev.append(CRLF_STR, CRLF_LEN);
+
+  // Frame the event as one HTTP chunk, so it can be sent with a single call
+  auto chunk = std::make_shared<std::string>(str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size()));
+  chunk->reserve(chunk->size() + ev.size() + CRLF_LEN);
+  chunk->append(ev);
+  chunk->append(CRLF_STR, CRLF_LEN);
+  return chunk;
 }
 
 AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server)
@@ -313,56 +421,86 @@ AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *
 
 void AsyncEventSourceResponse::destroy(void *ptr) {
   auto *rsp = static_cast<AsyncEventSourceResponse *>(ptr);
-  rsp->server_->sessions_.erase(rsp);
+  {
+    // called from the httpd task, waits until the main loop is done with the session
+    LockGuard guard(rsp->server_->sessions_lock_);
+    rsp->server_->sessions_.erase(rsp);
+  }
   delete rsp;  // NOLINT(cppcoreguidelines-owning-memory)
 }
 
 void AsyncEventSourceResponse::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
-  if (this->fd_ == 0) {
+  auto chunk = AsyncEventSource::format_chunk_(message, event, id, reconnect);
+  if (chunk == nullptr)
     return;
-  }
-
-  std::string ev;
+  // Only called before the session is added to the server, without the sessions lock
+  const int fd = this->fd_;
+  const int reason = this->enqueue_(std::move(chunk), nullptr);
+  if (reason != 0)
+    log_closed_(fd, reason);
+}
 
-  if (reconnect) {
-    ev.append("retry: ", sizeof("retry: ") - 1);
-    ev.append(to_string(reconnect));
-    ev.append(CRLF_STR, CRLF_LEN);
+void AsyncEventSourceResponse::log_closed_(int fd, int reason) {
+  if (reason == EVENT_QUEUE_FULL) {
+    ESP_LOGW(TAG, "Event client on socket %d is not keeping up, disconnecting", fd);
+  } else {
+    ESP_LOGD(TAG, "Sending event to socket %d failed: %d", fd, reason);
   }
+}
 
-  if (id) {
-    ev.append("id: ", sizeof("id: ") - 1);
-    ev.append(to_string(id));
-    ev.append(CRLF_STR, CRLF_LEN);
+int AsyncEventSourceResponse::enqueue_(std::shared_ptr<const std::string> chunk, const void *key) {
+  if (this->fd_ == 0) {
+    return 0;
   }
 
-  if (event && *event) {
-    ev.append("event: ", sizeof("event: ") - 1);
-    ev.append(event);
-    ev.append(CRLF_STR, CRLF_LEN);
+  if (key != nullptr) {
+    // The front event may be partially sent already, it has to stay
+    for (auto it = this->queue_.begin() + (this->queue_offset_ != 0 ? 1 : 0); it != this->queue_.end(); ++it) {
+      if (it->key == key) {
+        this->queue_.erase(it);
+        break;
+      }
+    }
   }
 
-  if (message && *message) {
-    ev.append("data: ", sizeof("data: ") - 1);
-    ev.append(message);
-    ev.append(CRLF_STR, CRLF_LEN);
+  if (this->queue_.size() >= MAX_QUEUED_EVENTS) {
+    this->close_();
+    return EVENT_QUEUE_FULL;
   }
+  this->queue_.push_back({std::move(chunk), key});
+  return this->flush_();
+}
 
-  if (ev.empty()) {
-    return;
+int AsyncEventSourceResponse::flush_() {
+  while (this->fd_ != 0 && !this->queue_.empty()) {
+    const std::string &chunk = *this->queue_.front().chunk;
+    // Send on the socket directly, httpd_socket_send() logs a warning every time the socket buffer is full
+    ssize_t ret =
+        ::send(this->fd_, chunk.data() + this->queue_offset_, chunk.size() - this->queue_offset_, MSG_DONTWAIT);
+    if (ret < 0) {
+      const int error = errno;
+      if (error == EAGAIN || error == EWOULDBLOCK || error == EINTR) {
+        // socket buffer is full, continue from the main loop
+        return 0;
+      }
+      this->close_();
+      return error;
+    }
+    this->queue_offset_ += ret;
+    if (this->queue_offset_ == chunk.size()) {
+      this->queue_.pop_front();
+      this->queue_offset_ = 0;
+    }
   }
+  return 0;
+}
 
-  ev.append(CRLF_STR, CRLF_LEN);
-
-  // Sending chunked content prelude
-  auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
-  httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
-
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
-
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
+void AsyncEventSourceResponse::close_() {
+  // The session is freed through destroy() once the server has closed it
+  httpd_sess_trigger_close(this->hd_, this->fd_);
+  this->fd_ = 0;
+  this->queue_.clear();
+  this->queue_offset_ = 0;
 }
 
 }  // namespace web_server_idf
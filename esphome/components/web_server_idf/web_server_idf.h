@@ -3,12 +3,17 @@
 
 #include <esp_http_server.h>
 
+#include <cstring>
+#include <deque>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "esphome/core/helpers.h"
+
 namespace esphome {
 namespace web_server_idf {
 
@@ -34,11 +39,18 @@ class AsyncWebServerResponse {
   AsyncWebServerResponse(const AsyncWebServerRequest *req) : req_(req) {}
   virtual ~AsyncWebServerResponse() {}
 
+  /** Add a header to the response.
+   *
+   * Headers are sent with the first chunk, so on a response that has already sent part of its content, such as an
+   * AsyncResponseStream that buffered more than CHUNK_SIZE bytes, the header is ignored with a warning.
+   */
   // NOLINTNEXTLINE(readability-identifier-naming)
   void addHeader(const char *name, const char *value);
 
   virtual const char *get_content_data() const = 0;
   virtual size_t get_content_size() const = 0;
+  /// Whether part of the content was already sent as chunks, the content data is what is left to send.
+  virtual bool is_chunked() const { return false; }
 
  protected:
   const AsyncWebServerRequest *req_;
@@ -70,14 +82,34 @@ class AsyncResponseStream : public AsyncWebServerResponse {
 
   const char *get_content_data() const override { return this->content_.c_str(); };
   size_t get_content_size() const override { return this->content_.size(); };
+  bool is_chunked() const override { return this->chunked_; }
 
-  void print(const char *str) { this->content_.append(str); }
-  void print(const std::string &str) { this->content_.append(str); }
+  void print(const char *str) { this->append_(str, strlen(str)); }
+  void print(const std::string &str) { this->append_(str.data(), str.size()); }
   void print(float value);
   void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+  size_t write(const uint8_t *data, size_t len) {
+    this->append_(reinterpret_cast<const char *>(data), len);
+    return len;
+  }
 
  protected:
+  /** Content is sent as a chunk whenever this much is buffered, so large responses don't have to fit in memory.
+   *
+   * The first chunk also sends the headers, so addHeader() has to be called before anything is printed.
+   */
+  static const size_t CHUNK_SIZE = 1436;
+
+  void append_(const char *data, size_t len) {
+    this->content_.append(data, len);
+    if (this->content_.size() >= CHUNK_SIZE)
+      this->send_chunk_();
+  }
+  void send_chunk_();
+
   std::string content_;
+  bool chunked_{false};
+  bool failed_{false};
 };
 
 class AsyncWebServerResponseProgmem : public AsyncWebServerResponse {
@@ -223,11 +255,32 @@ class AsyncEventSourceResponse {
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
 
  protected:
+  /// Events queued for a client that doesn't keep up before it gets disconnected.
+  static const size_t MAX_QUEUED_EVENTS = 32;
+
+  struct QueuedEvent {
+    std::shared_ptr<const std::string> chunk;
+    const void *key;
+  };
+
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
   static void destroy(void *p);
+  /** Queue a formatted chunk, replacing a queued chunk with the same key that hasn't been started yet.
+   *
+   * @return 0, or the reason the session was closed, to be passed to log_closed_() once the sessions lock is
+   *         released. Logging with the lock held deadlocks when the log is forwarded to the event source.
+   */
+  int enqueue_(std::shared_ptr<const std::string> chunk, const void *key);
+  /// Send as much of the queue as the socket takes without blocking, returns the same as enqueue_().
+  int flush_();
+  static void log_closed_(int fd, int reason);
+  void close_();
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
+  std::deque<QueuedEvent> queue_;
+  /// Bytes of the front chunk already sent.
+  size_t queue_offset_{0};
 };
 
 using AsyncEventSourceClient = AsyncEventSourceResponse;
@@ -249,13 +302,27 @@ class AsyncEventSource : public AsyncWebHandler {
   // NOLINTNEXTLINE(readability-identifier-naming)
   void onConnect(connect_handler_t cb) { this->on_connect_ = std::move(cb); }
 
-  void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  /** Send an event to all clients.
+   *
+   * The event is formatted once and the buffer is shared by the queues of all clients. If \p key is set, an event
+   * with the same key that is still waiting in a client's queue is dropped, as this one supersedes it.
+   */
+  void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0,
+            const void *key = nullptr);
 
-  size_t count() const { return this->sessions_.size(); }
+  /// Continue sending queued events, call from the main loop.
+  void loop();
+
+  size_t count() const;
 
  protected:
+  static std::shared_ptr<const std::string> format_chunk_(const char *message, const char *event, uint32_t id,
+                                                           uint32_t reconnect);
+
   std::string url_;
   std::set<AsyncEventSourceResponse *> sessions_;
+  /// Guards sessions_ and the sessions in it, sessions are added and freed by the httpd task.
+  mutable Mutex sessions_lock_;
   connect_handler_t on_connect_{};
 };
 
@@ -52,24 +52,20 @@ struct XiaomiParseResult {
   int raw_offset;
 };
 
-struct XiaomiAESVector {
-  uint8_t key[16];
-  uint8_t plaintext[16];
-  uint8_t ciphertext[16];
-  uint8_t authdata[16];
-  uint8_t iv[16];
-  uint8_t tag[16];
-  size_t keysize;
-  size_t authsize;
-  size_t datasize;
-  size_t tagsize;
-  size_t ivsize;
-};
-
 bool parse_xiaomi_value(uint16_t value_type, const uint8_t *data, uint8_t value_length, XiaomiParseResult &result);
 bool parse_xiaomi_message(const std::vector<uint8_t> &message, XiaomiParseResult &result);
 optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::ServiceData &service_data);
 bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address);
+
+/// Counters of decrypt_xiaomi_payload() calls for one bindkey.
+struct XiaomiDecryptStats {
+  uint32_t decrypted{0};
+  uint32_t failed{0};
+  /// Total time spent in decryption, in microseconds.
+  uint32_t total_us{0};
+};
+/// Statistics of the payloads decrypted with \p bindkey so far, all zero if it was never used.
+XiaomiDecryptStats get_xiaomi_decrypt_stats(const uint8_t *bindkey);
 bool report_xiaomi_results(const optional<XiaomiParseResult> &result, const std::string &address);
 
 class XiaomiListener : public esp32_ble_tracker::ESPBTDeviceListener {
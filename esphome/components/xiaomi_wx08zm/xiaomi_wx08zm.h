@@ -15,7 +15,10 @@ class XiaomiWX08ZM : public Component,
                      public binary_sensor::BinarySensorInitiallyOff,
                      public esp32_ble_tracker::ESPBTDeviceListener {
  public:
-  void set_address(uint64_t address) { address_ = address; }
+  void set_address(uint64_t address) {
+    this->address_ = address;
+    this->add_address_filter(address);
+  }
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 
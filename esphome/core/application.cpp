@@ -7,10 +7,19 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_HOST
+#include <fcntl.h>
+#include <sys/select.h>
+#include <unistd.h>
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+/// Longest idle sleep when every looping component only runs on wake, keeps the watchdog fed.
+static const uint32_t MAX_WAKE_ONLY_SLEEP = 1000;
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +36,7 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+  this->setup_wake_();
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -60,17 +70,28 @@ void Application::setup() {
   }
 
   ESP_LOGI(TAG, "setup() finished successfully!");
+  this->setup_complete_ = true;
   this->schedule_dump_config();
   this->calculate_looping_components_();
 }
 void Application::loop() {
   uint32_t new_app_state = 0;
+  uint16_t skipped = 0;
 
   this->scheduler.call();
   this->feed_wdt();
   for (Component *component : this->looping_components_) {
+    if (component->loop_on_wake_) {
+      if (!component->wake_pending_) {
+        skipped++;
+        new_app_state |= component->get_component_state();
+        continue;
+      }
+      // Clear before calling so wakes raised during loop() are not lost
+      component->wake_pending_ = false;
+    }
     {
-      WarnIfComponentBlockingGuard guard{component};
+      WarnIfComponentBlockingGuard guard{component, WarnIfComponentBlockingGuard::CALL_LOOP};
       component->call();
     }
     new_app_state |= component->get_component_state();
@@ -78,11 +99,22 @@ void Application::loop() {
     this->feed_wdt();
   }
   this->app_state_ = new_app_state;
+  this->loop_skipped_components_ = skipped;
+  this->total_loop_skipped_components_ += skipped;
 
   const uint32_t now = millis();
 
   auto elapsed = now - this->last_loop_;
-  if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
+  if (HighFrequencyLoopRequester::is_high_frequency()) {
+    yield();
+#if defined(USE_ESP32) || defined(USE_HOST)
+  } else if (!this->looping_components_.empty() && skipped == this->looping_components_.size() &&
+             this->dump_config_at_ >= this->components_.size()) {
+    // Nothing needs polling, sleep until the next scheduled item or until woken
+    uint32_t delay_time = this->scheduler.next_schedule_in().value_or(MAX_WAKE_ONLY_SLEEP);
+    this->sleep_until_wake_(std::min(delay_time, MAX_WAKE_ONLY_SLEEP));
+#endif
+  } else if (elapsed >= this->loop_interval_) {
     yield();
   } else {
     uint32_t delay_time = this->loop_interval_ - elapsed;
@@ -91,7 +123,7 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->sleep_until_wake_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -143,6 +175,76 @@ void Application::run_safe_shutdown_hooks() {
   }
 }
 
+void Application::setup_wake_() {
+#if defined(USE_ESP32)
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#elif defined(USE_HOST)
+  this->main_thread_ = pthread_self();
+  this->main_thread_set_ = true;
+  if (::pipe(this->wake_fds_) != 0) {
+    ESP_LOGW(TAG, "Could not create wake pipe, loop wakes are disabled");
+    this->wake_fds_[0] = this->wake_fds_[1] = -1;
+    return;
+  }
+  for (int fd : this->wake_fds_)
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+void IRAM_ATTR Application::wake_loop() {
+#if defined(USE_ESP32)
+  if (this->main_task_ == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(this->main_task_, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+  } else {
+    xTaskNotifyGive(this->main_task_);
+  }
+#elif defined(USE_HOST)
+  if (this->wake_fds_[1] < 0)
+    return;
+  const uint8_t byte = 1;
+  // A full pipe already guarantees a wake, so a failed write can be ignored
+  (void) ::write(this->wake_fds_[1], &byte, 1);
+#endif
+}
+
+bool Application::in_loop_task() const {
+#if defined(USE_ESP32)
+  return this->main_task_ == nullptr || xTaskGetCurrentTaskHandle() == this->main_task_;
+#elif defined(USE_HOST)
+  return !this->main_thread_set_ || pthread_equal(pthread_self(), this->main_thread_);
+#else
+  return true;
+#endif
+}
+
+void Application::sleep_until_wake_(uint32_t ms) {
+#if defined(USE_ESP32)
+  ulTaskNotifyTake(pdTRUE, ms / portTICK_PERIOD_MS);
+#elif defined(USE_HOST)
+  if (this->wake_fds_[0] < 0) {
+    delay(ms);
+    return;
+  }
+  fd_set fds;
+  FD_ZERO(&fds);
+  FD_SET(this->wake_fds_[0], &fds);
+  struct timeval tv;
+  tv.tv_sec = ms / 1000;
+  tv.tv_usec = (ms % 1000) * 1000;
+  if (::select(this->wake_fds_[0] + 1, &fds, nullptr, nullptr, &tv) > 0) {
+    uint8_t buf[16];
+    while (::read(this->wake_fds_[0], buf, sizeof(buf)) > 0) {
+    }
+  }
+#else
+  delay(ms);
+#endif
+}
+
 void Application::calculate_looping_components_() {
   for (auto *obj : this->components_) {
     if (obj->has_overridden_loop())
@@ -9,6 +9,14 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+#ifdef USE_HOST
+#include <pthread.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -231,10 +239,31 @@ class Application {
 
   uint32_t get_loop_interval() const { return this->loop_interval_; }
 
+  /** Wake the main loop up from its idle sleep. Safe to call from other tasks and from ISRs.
+   *
+   * Used by Component::wake_loop() so components in loop-on-wake mode get their loop() called
+   * right away. On platforms without a wake primitive this is a no-op and the wake is picked up
+   * on the next regular loop iteration.
+   */
+  void wake_loop();
+
+  /// Whether the caller runs on the task that runs the main loop, always true on platforms without other tasks.
+  bool in_loop_task() const;
+
+  /// Number of component loop() calls skipped in the last iteration because no wake was pending.
+  uint16_t get_loop_skipped_components() const { return this->loop_skipped_components_; }
+  /// Total number of component loop() calls skipped since boot.
+  uint32_t get_total_loop_skipped_components() const { return this->total_loop_skipped_components_; }
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
+  /// Whether setup() has returned and the main loop is running.
+  bool is_setup_complete() const { return this->setup_complete_; }
+
   void feed_wdt();
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
   void reboot();
 
   void safe_reboot();
@@ -470,6 +499,10 @@ class Application {
 
   void feed_wdt_arch_();
 
+  void setup_wake_();
+  /// Sleep for up to \p ms, returning early when wake_loop() is called.
+  void sleep_until_wake_(uint32_t ms);
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
@@ -547,6 +580,16 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+  uint16_t loop_skipped_components_{0};
+  uint32_t total_loop_skipped_components_{0};
+  bool setup_complete_{false};
+#if defined(USE_ESP32)
+  TaskHandle_t main_task_{nullptr};
+#elif defined(USE_HOST)
+  int wake_fds_[2]{-1, -1};
+  pthread_t main_thread_{};
+  bool main_thread_set_{false};
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -1,5 +1,6 @@
 #include "esphome/core/component.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <utility>
 #include "esphome/core/application.h"
@@ -11,6 +12,11 @@ namespace esphome {
 
 static const char *const TAG = "component";
 
+// Timers without an id can't be cancelled.
+static const uint32_t ANONYMOUS_TIMER_ID = 0;
+// Id of the polling interval, the hash of its former name so cancel_interval("update") keeps working.
+static const uint32_t UPDATE_INTERVAL_ID = fnv1_hash("update");  // NOLINT
+
 namespace setup_priority {
 
 const float BUS = 1000.0f;
@@ -53,10 +59,18 @@ void Component::set_interval(const std::string &name, uint32_t interval, std::fu
   App.scheduler.set_interval(this, name, interval, std::move(f));
 }
 
+void Component::set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval(this, id, interval, std::move(f));
+}
+
 bool Component::cancel_interval(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_interval(this, name);
 }
 
+bool Component::cancel_interval(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_interval(this, id);
+}
+
 void Component::set_retry(const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                           std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor) {  // NOLINT
   App.scheduler.set_retry(this, name, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
@@ -70,10 +84,18 @@ void Component::set_timeout(const std::string &name, uint32_t timeout, std::func
   App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
 
+void Component::set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, id, timeout, std::move(f));
+}
+
 bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+bool Component::cancel_timeout(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, id);
+}
+
 void Component::call_loop() { this->loop(); }
 void Component::call_setup() { this->setup(); }
 void Component::call_dump_config() {
@@ -91,7 +113,15 @@ void Component::call() {
       // State Construction: Call setup and set state to setup
       this->component_state_ &= ~COMPONENT_STATE_MASK;
       this->component_state_ |= COMPONENT_STATE_SETUP;
+#ifdef USE_COMPONENT_PROFILER
+      {
+        const uint32_t start = micros();
+        this->call_setup();
+        this->profile_.setup_us = micros() - start;
+      }
+#else
       this->call_setup();
+#endif
       break;
     case COMPONENT_STATE_SETUP:
       // State setup: Call first loop and set state to loop
@@ -121,8 +151,12 @@ void Component::mark_failed() {
   this->component_state_ |= COMPONENT_STATE_FAILED;
   this->status_set_error();
 }
+void IRAM_ATTR Component::wake_loop() {
+  this->wake_pending_ = true;
+  App.wake_loop();
+}
 void Component::defer(std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", 0, std::move(f));
+  App.scheduler.set_timeout(this, ANONYMOUS_TIMER_ID, 0, std::move(f));
 }
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
@@ -131,10 +165,10 @@ void Component::defer(const std::string &name, std::function<void()> &&f) {  //
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+  App.scheduler.set_timeout(this, ANONYMOUS_TIMER_ID, timeout, std::move(f));
 }
 void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, "", interval, std::move(f));
+  App.scheduler.set_interval(this, ANONYMOUS_TIMER_ID, interval, std::move(f));
 }
 void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,
                           float backoff_increase_factor) {  // NOLINT
@@ -217,20 +251,35 @@ void PollingComponent::call_setup() {
 
 void PollingComponent::start_poller() {
   // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+  this->set_interval(UPDATE_INTERVAL_ID, this->get_update_interval(), [this]() { this->update(); });
 }
 
 void PollingComponent::stop_poller() {
   // Clear the interval to suspend component
-  this->cancel_interval("update");
+  this->cancel_interval(UPDATE_INTERVAL_ID);
 }
 
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
-WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component)
-    : started_(millis()), component_(component) {}
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, CallType type)
+    : started_(millis()), component_(component) {
+#ifdef USE_COMPONENT_PROFILER
+  this->started_us_ = micros();
+  this->type_ = type;
+#endif
+}
 WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
+#ifdef USE_COMPONENT_PROFILER
+  if (this->component_ != nullptr) {
+    const uint32_t duration_us = micros() - this->started_us_;
+    if (this->type_ == CALL_LOOP) {
+      this->component_->profile_.record_loop(duration_us);
+    } else if (this->type_ == CALL_SCHEDULER) {
+      this->component_->profile_.record_scheduler(duration_us);
+    }
+  }
+#endif
   uint32_t now = millis();
   if (now - started_ > 50) {
     const char *src = component_ == nullptr ? "<null>" : component_->get_component_source();
@@ -240,4 +289,38 @@ WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
   }
 }
 
+#ifdef USE_COMPONENT_PROFILER
+void ComponentProfile::record_loop(uint32_t duration_us) {
+  this->loop_count++;
+  this->loop_total_us += duration_us;
+  this->loop_max_us = std::max(this->loop_max_us, duration_us);
+  uint8_t bucket = 0;
+  while (bucket < HISTOGRAM_BUCKETS - 1 && (duration_us >> bucket) != 0)
+    bucket++;
+  this->loop_histogram[bucket]++;
+}
+void ComponentProfile::record_scheduler(uint32_t duration_us) {
+  this->scheduler_count++;
+  this->scheduler_total_us += duration_us;
+  this->scheduler_max_us = std::max(this->scheduler_max_us, duration_us);
+}
+uint32_t ComponentProfile::loop_percentile_us(uint8_t percentile) const {
+  if (this->loop_count == 0)
+    return 0;
+  const uint64_t target = ((uint64_t) this->loop_count * percentile + 99) / 100;
+  uint64_t seen = 0;
+  for (uint8_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+    seen += this->loop_histogram[bucket];
+    if (seen >= target)
+      return std::min<uint32_t>(1UL << bucket, this->loop_max_us);
+  }
+  return this->loop_max_us;
+}
+void ComponentProfile::reset() {
+  const uint32_t setup_us = this->setup_us;
+  *this = ComponentProfile{};
+  this->setup_us = setup_us;
+}
+#endif
+
 }  // namespace esphome
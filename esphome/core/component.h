@@ -5,6 +5,7 @@
 #include <functional>
 #include <string>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -65,6 +66,37 @@ extern const uint32_t STATUS_LED_ERROR;
 
 enum class RetryResult { DONE, RETRY };
 
+#ifdef USE_COMPONENT_PROFILER
+/** Timing statistics of a single component, collected when the component profiler is enabled.
+ *
+ * loop() times are also recorded in a log2 histogram so percentiles can be estimated without
+ * keeping individual samples.
+ *
+ * Every component carries one of these (136 bytes on the 32-bit targets), so it only exists when the profiler is
+ * enabled with `profiler: true` on the debug component or one of the debug sensors that need it.
+ */
+struct ComponentProfile {
+  /// Bucket i counts calls that took less than 2^i microseconds (and at least 2^(i-1)).
+  static const uint8_t HISTOGRAM_BUCKETS = 24;
+
+  uint32_t loop_count{0};
+  uint64_t loop_total_us{0};
+  uint32_t loop_max_us{0};
+  uint32_t loop_histogram[HISTOGRAM_BUCKETS]{};
+  uint32_t scheduler_count{0};
+  uint64_t scheduler_total_us{0};
+  uint32_t scheduler_max_us{0};
+  uint32_t setup_us{0};
+
+  void record_loop(uint32_t duration_us);
+  void record_scheduler(uint32_t duration_us);
+  /// Upper bound (in microseconds) of the loop() time that \p percentile percent of all calls stayed below.
+  uint32_t loop_percentile_us(uint8_t percentile) const;
+  /// Clear the loop and scheduler statistics, the setup time is kept.
+  void reset();
+};
+#endif
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -142,6 +174,14 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Request a loop() call for a component in loop-on-wake mode and wake the main loop up.
+   *
+   * Safe to call from ISRs and other tasks.
+   *
+   * @see set_loop_on_wake()
+   */
+  void wake_loop();
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -153,8 +193,13 @@ class Component {
    */
   const char *get_component_source() const;
 
+#ifdef USE_COMPONENT_PROFILER
+  ComponentProfile &get_profile() { return this->profile_; }
+#endif
+
  protected:
   friend class Application;
+  friend class WarnIfComponentBlockingGuard;
 
   virtual void call_loop();
   virtual void call_setup();
@@ -177,6 +222,9 @@ class Component {
    */
   void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /// Set an interval function identified by a numeric id instead of a name, id 0 means no cancelling possible.
+  void set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
   /** Cancel an interval function.
@@ -185,6 +233,7 @@ class Component {
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(uint32_t id);               // NOLINT
 
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
@@ -245,6 +294,9 @@ class Component {
    */
   void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /// Set a timeout function identified by a numeric id instead of a name, id 0 means no cancelling possible.
+  void set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
   /** Cancel a timeout function.
@@ -253,6 +305,7 @@ class Component {
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(uint32_t id);               // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -269,9 +322,24 @@ class Component {
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
 
+  /** Only call loop() after wake_loop() was requested instead of on every main loop iteration.
+   *
+   * Meant for components whose loop() only checks for pending work (a readable socket, a flag set
+   * by an ISR, a non-empty ring buffer). When all looping components are in this mode the main loop
+   * sleeps until the next scheduled item or the next wake.
+   *
+   * @param loop_on_wake Whether loop() should only be called when woken.
+   */
+  void set_loop_on_wake(bool loop_on_wake) { this->loop_on_wake_ = loop_on_wake; }
+
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+  bool loop_on_wake_{false};
+  volatile bool wake_pending_{true};
+#ifdef USE_COMPONENT_PROFILER
+  ComponentProfile profile_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -321,12 +389,19 @@ class PollingComponent : public Component {
 
 class WarnIfComponentBlockingGuard {
  public:
-  WarnIfComponentBlockingGuard(Component *component);
+  /// What the guarded call is, used to attribute the time when the component profiler is enabled.
+  enum CallType : uint8_t { CALL_OTHER, CALL_LOOP, CALL_SCHEDULER };
+
+  WarnIfComponentBlockingGuard(Component *component, CallType type = CALL_OTHER);
   ~WarnIfComponentBlockingGuard();
 
  protected:
   uint32_t started_;
   Component *component_;
+#ifdef USE_COMPONENT_PROFILER
+  uint32_t started_us_;
+  CallType type_;
+#endif
 };
 
 }  // namespace esphome
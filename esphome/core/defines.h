@@ -22,11 +22,14 @@
 #define USE_AUDIO_FLAC_SUPPORT
 #define USE_AUDIO_MP3_SUPPORT
 #define USE_API
+#define USE_API_BATCHING
+#define USE_API_BINARY_LOGS
 #define USE_API_NOISE
 #define USE_API_PLAINTEXT
 #define USE_BINARY_SENSOR
 #define USE_BUTTON
 #define USE_CLIMATE
+#define USE_COMPONENT_PROFILER
 #define USE_COVER
 #define USE_DATETIME
 #define USE_DATETIME_DATE
@@ -45,6 +48,7 @@
 #define USE_LIGHT
 #define USE_LOCK
 #define USE_LOGGER
+#define USE_LOGGER_RAW_CALLBACK
 #define USE_LVGL
 #define USE_LVGL_ANIMIMG
 #define USE_LVGL_BINARY_SENSOR
@@ -110,6 +114,7 @@
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
+#define USE_LOGGER_TASK_LOG_BUFFER
 #define USE_MICRO_WAKE_WORD_VAD
 #define USE_MICROPHONE
 #define USE_PSRAM
@@ -46,6 +46,14 @@ class ESPPreferences {
    */
   virtual bool sync() = 0;
 
+  /**
+   * Commit pending writes to flash from the periodic syncer. Backends may postpone values that were written
+   * recently, anything left pending is committed by a later call or by sync().
+   *
+   * @return true if write is successful.
+   */
+  virtual bool sync_periodic() { return this->sync(); }
+
   /**
    * Forget all unsaved changes and re-initialize the permanent preferences storage.
    * Usually followed by a restart which moves the system to "factory" conditions
@@ -1,4 +1,5 @@
 #include "scheduler.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
@@ -10,6 +11,8 @@ namespace esphome {
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+// Upper bound on finished items kept for reuse instead of being freed.
+static const size_t MAX_POOLED_ITEMS = 16;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -21,36 +24,54 @@ static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> func) {
+  this->set_timeout_(component, name_to_id_(name), name_check_(name), timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t id, uint32_t timeout, std::function<void()> func) {
+  this->set_timeout_(component, id, 0, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout_(Component *component, uint32_t id, uint32_t name_check, uint32_t timeout,
+                                 std::function<void()> func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+  if (id != 0)
+    this->cancel_item_(component, id, name_check, SchedulerItem::TIMEOUT);
 
   if (timeout == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
+  ESP_LOGVV(TAG, "set_timeout(id=0x%08" PRIX32 ", timeout=%" PRIu32 ")", id, timeout);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
-  item->name = name;
+  item->id = id;
+  item->name_check = name_check;
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
   item->last_execution = now;
   item->last_execution_major = this->millis_major_;
   item->callback = std::move(func);
   item->remove = false;
-  this->push_(std::move(item));
+  this->push_(std::move(item), true);
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_item_(component, name_to_id_(name), name_check_(name), SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t id) {
+  return this->cancel_item_(component, id, 0, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> func) {
+  this->set_interval_(component, name_to_id_(name), name_check_(name), interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, uint32_t id, uint32_t interval, std::function<void()> func) {
+  this->set_interval_(component, id, 0, interval, std::move(func));
+}
+void HOT Scheduler::set_interval_(Component *component, uint32_t id, uint32_t name_check, uint32_t interval,
+                                  std::function<void()> func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (id != 0)
+    this->cancel_item_(component, id, name_check, SchedulerItem::INTERVAL);
 
   if (interval == SCHEDULER_DONT_RUN)
     return;
@@ -60,11 +81,12 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   if (interval != 0)
     offset = (random_uint32() % interval) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
+  ESP_LOGVV(TAG, "set_interval(id=0x%08" PRIX32 ", interval=%" PRIu32 ", offset=%" PRIu32 ")", id, interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
-  item->name = name;
+  item->id = id;
+  item->name_check = name_check;
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
   item->last_execution = now - offset - interval;
@@ -73,10 +95,13 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
     item->last_execution_major--;
   item->callback = std::move(func);
   item->remove = false;
-  this->push_(std::move(item));
+  this->push_(std::move(item), true);
 }
 bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+  return this->cancel_item_(component, name_to_id_(name), name_check_(name), SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t id) {
+  return this->cancel_item_(component, id, 0, SchedulerItem::INTERVAL);
 }
 
 struct RetryArgs {
@@ -135,14 +160,24 @@ bool HOT Scheduler::cancel_retry(Component *component, const std::string &name)
 }
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
-  if (this->empty_())
-    return {};
-  auto &item = this->items_[0];
   const uint32_t now = this->millis_();
-  uint32_t next_time = item->last_execution + item->interval;
-  if (next_time < now)
-    return 0;
-  return next_time - now;
+  auto time_until = [now](const SchedulerItem &item) -> uint32_t {
+    const uint32_t next_time = item.last_execution + item.interval;
+    return next_time < now ? 0 : next_time - now;
+  };
+  optional<uint32_t> next_in;
+  if (!this->empty_())
+    next_in = time_until(*this->items_[0]);
+  // Timers set since the last call() (e.g. from a component's loop()) are not in the heap yet
+  LockGuard guard{this->lock_};
+  for (auto &item : this->to_add_) {
+    if (item->remove)
+      continue;
+    const uint32_t in = time_until(*item);
+    if (!next_in.has_value() || in < *next_in)
+      next_in = in;
+  }
+  return next_in;
 }
 void HOT Scheduler::call() {
   const uint32_t now = this->millis_();
@@ -161,8 +196,8 @@ void HOT Scheduler::call() {
       this->pop_raw_();
       this->lock_.unlock();
 
-      ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
+      ESP_LOGVV(TAG, "  %s 0x%08" PRIX32 " interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
+                item->get_type_str(), item->id, item->interval, item->last_execution,
                 item->last_execution_major, item->next_execution(), item->next_execution_major());
 
       old_items.push_back(std::move(item));
@@ -176,29 +211,30 @@ void HOT Scheduler::call() {
   }
 #endif  // ESPHOME_DEBUG_SCHEDULER
 
-  auto to_remove_was = to_remove_;
-  auto items_was = this->items_.size();
   // If we have too many items to remove
   if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
-    std::vector<std::unique_ptr<SchedulerItem>> valid_items;
-    while (!this->empty_()) {
-      LockGuard guard{this->lock_};
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
-    }
-
+    // drop them all at once and re-heapify in linear time, instead of popping every item
+    std::vector<std::unique_ptr<SchedulerItem>> removed;
     {
       LockGuard guard{this->lock_};
-      this->items_ = std::move(valid_items);
-    }
+      auto first_removed = std::partition(this->items_.begin(), this->items_.end(),
+                                          [](const std::unique_ptr<SchedulerItem> &item) { return !item->remove; });
+      for (auto it = first_removed; it != this->items_.end(); ++it) {
+        this->unindex_item_(it->get());
+        removed.push_back(std::move(*it));
+      }
+      this->items_.erase(first_removed, this->items_.end());
+      std::make_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
 
-    // The following should not happen unless I'm missing something
-    if (to_remove_ != 0) {
-      ESP_LOGW(TAG, "to_remove_ was %" PRIu32 " now: %" PRIu32 " items where %zu now %zu. Please report this",
-               to_remove_was, to_remove_, items_was, items_.size());
+      // The following should not happen unless I'm missing something
+      if (to_remove_ != removed.size()) {
+        ESP_LOGW(TAG, "to_remove_ was %" PRIu32 " but %zu items were removed. Please report this", to_remove_,
+                 removed.size());
+      }
       to_remove_ = 0;
     }
+    for (auto &item : removed)
+      this->recycle_item_(std::move(item));
   }
 
   while (!this->empty_()) {
@@ -216,21 +252,28 @@ void HOT Scheduler::call() {
 
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
-        LockGuard guard{this->lock_};
-        this->pop_raw_();
+        std::unique_ptr<SchedulerItem> failed;
+        {
+          LockGuard guard{this->lock_};
+          failed = std::move(this->items_[0]);
+          this->pop_raw_();
+          this->unindex_item_(failed.get());
+        }
+        this->recycle_item_(std::move(failed));
         continue;
       }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+      ESP_LOGVV(TAG,
+                "Running %s 0x%08" PRIX32 " with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
+                item->get_type_str(), item->id, item->interval, item->last_execution, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
       {
-        WarnIfComponentBlockingGuard guard{item->component};
+        WarnIfComponentBlockingGuard guard{item->component, WarnIfComponentBlockingGuard::CALL_SCHEDULER};
         item->callback();
       }
     }
@@ -245,40 +288,58 @@ void HOT Scheduler::call() {
       // during the function call and know if we were cancelled.
       this->pop_raw_();
 
-      this->lock_.unlock();
-
-      if (item->remove) {
-        // We were removed/cancelled in the function call, stop
-        to_remove_--;
+      if (item->remove || item->type == SchedulerItem::TIMEOUT) {
+        if (item->remove) {
+          // We were removed/cancelled in the function call, stop
+          to_remove_--;
+        }
+        this->unindex_item_(item.get());
+        this->lock_.unlock();
+        this->recycle_item_(std::move(item));
         continue;
       }
 
-      if (item->type == SchedulerItem::INTERVAL) {
-        if (item->interval != 0) {
-          const uint32_t before = item->last_execution;
-          const uint32_t amount = (now - item->last_execution) / item->interval;
-          item->last_execution += amount * item->interval;
-          if (item->last_execution < before)
-            item->last_execution_major++;
-        }
-        this->push_(std::move(item));
+      // cancelling the interval until it is pushed back must not count towards to_remove_
+      item->in_heap = false;
+      this->lock_.unlock();
+
+      if (item->interval != 0) {
+        const uint32_t before = item->last_execution;
+        const uint32_t amount = (now - item->last_execution) / item->interval;
+        item->last_execution += amount * item->interval;
+        if (item->last_execution < before)
+          item->last_execution_major++;
       }
+      this->push_(std::move(item));
     }
   }
 
   this->process_to_add();
 }
 void HOT Scheduler::process_to_add() {
-  LockGuard guard{this->lock_};
-  for (auto &it : this->to_add_) {
-    if (it->remove) {
-      continue;
-    }
+  while (true) {
+    // cancelled items are recycled outside the lock, one at a time
+    std::unique_ptr<SchedulerItem> removed;
+    {
+      LockGuard guard{this->lock_};
+      while (!this->to_add_.empty()) {
+        auto item = std::move(this->to_add_.back());
+        this->to_add_.pop_back();
+        if (item->remove) {
+          this->unindex_item_(item.get());
+          removed = std::move(item);
+          break;
+        }
 
-    this->items_.push_back(std::move(it));
-    std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+        item->in_heap = true;
+        this->items_.push_back(std::move(item));
+        std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+      }
+    }
+    if (!removed)
+      return;
+    this->recycle_item_(std::move(removed));
   }
-  this->to_add_.clear();
 }
 void HOT Scheduler::cleanup_() {
   while (!this->items_.empty()) {
@@ -288,40 +349,110 @@ void HOT Scheduler::cleanup_() {
 
     to_remove_--;
 
+    std::unique_ptr<SchedulerItem> removed;
     {
       LockGuard guard{this->lock_};
+      removed = std::move(this->items_[0]);
       this->pop_raw_();
+      this->unindex_item_(removed.get());
     }
+    this->recycle_item_(std::move(removed));
   }
 }
 void HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
   this->items_.pop_back();
 }
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
+void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item, bool is_new) {
+  {
+    LockGuard guard{this->lock_};
+    item->in_heap = false;
+    if (is_new && item->id != 0) {
+      SchedulerItem *&bucket = this->item_index_[index_bucket_(item->id)];
+      item->index_next = bucket;
+      bucket = item.get();
+    }
+    this->to_add_.push_back(std::move(item));
+  }
+  // The main loop may be sleeping until the previous deadline, let it pick up work scheduled from other tasks
+  if (!App.in_loop_task())
+    App.wake_loop();
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_() {
+  {
+    LockGuard guard{this->lock_};
+    if (!this->item_pool_.empty()) {
+      auto item = std::move(this->item_pool_.back());
+      this->item_pool_.pop_back();
+      return item;
+    }
+  }
+  return make_unique<SchedulerItem>();
+}
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  // Release the callback now so captured state doesn't outlive the timer. This is done without the lock, as the
+  // destructors of captured objects may cancel or set timers themselves.
+  item->callback = nullptr;
   LockGuard guard{this->lock_};
-  this->to_add_.push_back(std::move(item));
+  if (this->item_pool_.size() < MAX_POOLED_ITEMS)
+    this->item_pool_.push_back(std::move(item));
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+void HOT Scheduler::unindex_item_(SchedulerItem *item) {
+  if (item->id == 0)
+    return;
+  for (SchedulerItem **link = &this->item_index_[index_bucket_(item->id)]; *link != nullptr;
+       link = &(*link)->index_next) {
+    if (*link == item) {
+      *link = item->index_next;
+      return;
+    }
+  }
+}
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t id, uint32_t name_check,
+                                 Scheduler::SchedulerItem::Type type) {
   // obtain lock because this function iterates and can be called from non-loop task context
   LockGuard guard{this->lock_};
   bool ret = false;
-  for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
-      to_remove_++;
-      it->remove = true;
-      ret = true;
+  if (id == 0) {
+    // anonymous timers aren't indexed
+    for (auto &it : this->items_) {
+      if (it->component == component && it->id == 0 && it->type == type && !it->remove) {
+        to_remove_++;
+        it->remove = true;
+        ret = true;
+      }
     }
-  }
-  for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
-      it->remove = true;
-      ret = true;
+    for (auto &it : this->to_add_) {
+      if (it->component == component && it->id == 0 && it->type == type) {
+        it->remove = true;
+        ret = true;
+      }
     }
+    return ret;
   }
 
+  for (SchedulerItem *item = this->item_index_[index_bucket_(id)]; item != nullptr; item = item->index_next) {
+    if (item->id != id || item->component != component || item->type != type || item->remove)
+      continue;
+    if (name_check != 0 && item->name_check != 0 && item->name_check != name_check)
+      continue;
+    // items outside the heap are dropped when they are (re-)added to it
+    if (item->in_heap)
+      to_remove_++;
+    item->remove = true;
+    ret = true;
+  }
   return ret;
 }
+uint32_t Scheduler::name_check_(const std::string &name) {
+  // FNV-1a with a different offset basis than the FNV-1 id, so names colliding in both are practically impossible
+  uint32_t hash = 0x811C9DC5UL ^ 0x5BD1E995UL;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
@@ -10,12 +10,23 @@ namespace esphome {
 
 class Component;
 
+/** The scheduler identifies timers by a 32-bit id instead of a name string.
+ *
+ * Name based calls are hashed to an id once on entry (an empty name maps to id 0, the anonymous timer), plus a
+ * second hash that tells apart names with the same id. Timers with an id are indexed by it, so cancelling and
+ * re-arming them doesn't scan all timers. Items are recycled through a small free list to avoid heap churn for
+ * components that constantly re-arm timeouts (e.g. delay actions and polling components).
+ */
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
+  void set_timeout(Component *component, uint32_t id, uint32_t timeout, std::function<void()> func);
   bool cancel_timeout(Component *component, const std::string &name);
+  bool cancel_timeout(Component *component, uint32_t id);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
+  void set_interval(Component *component, uint32_t id, uint32_t interval, std::function<void()> func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, uint32_t id);
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
@@ -30,7 +41,9 @@ class Scheduler {
  protected:
   struct SchedulerItem {
     Component *component;
-    std::string name;
+    uint32_t id;
+    /// Second hash of the name of timers set by name, 0 for timers set by id (those match any name with their id).
+    uint32_t name_check;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
@@ -39,6 +52,10 @@ class Scheduler {
     uint32_t last_execution;
     std::function<void()> callback;
     bool remove;
+    /// Whether the item is in the `items_` heap, only cancelling those counts towards `to_remove_`.
+    bool in_heap;
+    /// Next item in the same `item_index_` bucket.
+    SchedulerItem *index_next;
     uint8_t last_execution_major;
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
@@ -63,11 +80,31 @@ class Scheduler {
     }
   };
 
+  /// Hash a timer name to its id, empty names map to the anonymous id 0.
+  static uint32_t name_to_id_(const std::string &name) { return name.empty() ? 0 : fnv1_hash(name); }
+  /// Second, independent hash of a timer name, compared on an id match so two names with the same id don't replace
+  /// or cancel each other's timers.
+  static uint32_t name_check_(const std::string &name);
+
+  void set_timeout_(Component *component, uint32_t id, uint32_t name_check, uint32_t timeout,
+                    std::function<void()> func);
+  void set_interval_(Component *component, uint32_t id, uint32_t name_check, uint32_t interval,
+                     std::function<void()> func);
+
   uint32_t millis_();
   void cleanup_();
   void pop_raw_();
-  void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  /// Queue an item for `items_`. New timers are added to `item_index_` too.
+  void push_(std::unique_ptr<SchedulerItem> item, bool is_new = false);
+  std::unique_ptr<SchedulerItem> acquire_item_();
+  /// Return a finished item to the pool. Must be called without `lock_` held, destroying the callback can run
+  /// arbitrary destructors.
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
+  /// Remove an item that leaves `items_` or `to_add_` for good from `item_index_`. Must be called with `lock_` held.
+  void unindex_item_(SchedulerItem *item);
+  static size_t index_bucket_(uint32_t id) { return id % INDEX_BUCKETS; }
+  /// Cancel the timers with this id, and with this name too unless `name_check` is 0.
+  bool cancel_item_(Component *component, uint32_t id, uint32_t name_check, SchedulerItem::Type type);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -76,6 +113,12 @@ class Scheduler {
   Mutex lock_;
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  /// Finished items kept around for reuse, guarded by `lock_`.
+  std::vector<std::unique_ptr<SchedulerItem>> item_pool_;
+  /// Items with a non-zero id in `items_` or `to_add_`, chained through SchedulerItem::index_next in buckets by id.
+  /// Intrusive, so indexing a timer doesn't allocate. Guarded by `lock_`.
+  static const size_t INDEX_BUCKETS = 32;
+  SchedulerItem *item_index_[INDEX_BUCKETS]{};
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
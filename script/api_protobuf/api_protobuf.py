@@ -176,6 +176,26 @@ class TypeInfo(ABC):
 
     encode_func = None
 
+    @property
+    def field_id_size(self):
+        # Size of the field tag (field number + wire type) as varint
+        tag = self.number << 3
+        size = 1
+        while tag >= 0x80:
+            tag >>= 7
+            size += 1
+        return size
+
+    def get_size_calculation(self, name: str, force: bool = False) -> str:
+        force_arg = ", true" if force else ""
+        return f"ProtoSize::add_{self.size_func}_field(total_size, {self.field_id_size}, {name}{force_arg});"
+
+    @property
+    def calculate_size_content(self) -> str:
+        return self.get_size_calculation(f"this->{self.field_name}")
+
+    size_func = None
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -205,6 +225,7 @@ class DoubleType(TypeInfo):
     default_value = "0.0"
     decode_64bit = "value.as_double()"
     encode_func = "encode_double"
+    size_func = "double"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%g", {name});\n'
@@ -218,6 +239,7 @@ class FloatType(TypeInfo):
     default_value = "0.0f"
     decode_32bit = "value.as_float()"
     encode_func = "encode_float"
+    size_func = "float"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%g", {name});\n'
@@ -231,6 +253,7 @@ class Int64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_int64()"
     encode_func = "encode_int64"
+    size_func = "int64"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
@@ -244,6 +267,7 @@ class UInt64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_uint64()"
     encode_func = "encode_uint64"
+    size_func = "uint64"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
@@ -257,6 +281,7 @@ class Int32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_int32()"
     encode_func = "encode_int32"
+    size_func = "int32"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRId32, {name});\n'
@@ -270,6 +295,7 @@ class Fixed64Type(TypeInfo):
     default_value = "0"
     decode_64bit = "value.as_fixed64()"
     encode_func = "encode_fixed64"
+    size_func = "fixed64"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
@@ -283,6 +309,7 @@ class Fixed32Type(TypeInfo):
     default_value = "0"
     decode_32bit = "value.as_fixed32()"
     encode_func = "encode_fixed32"
+    size_func = "fixed32"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRIu32, {name});\n'
@@ -296,6 +323,7 @@ class BoolType(TypeInfo):
     default_value = "false"
     decode_varint = "value.as_bool()"
     encode_func = "encode_bool"
+    size_func = "bool"
 
     def dump(self, name):
         o = f"out.append(YESNO({name}));"
@@ -310,6 +338,7 @@ class StringType(TypeInfo):
     const_reference_type = "const std::string &"
     decode_length = "value.as_string()"
     encode_func = "encode_string"
+    size_func = "string"
 
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
@@ -332,6 +361,8 @@ class MessageType(TypeInfo):
     def const_reference_type(self):
         return f"const {self.cpp_type} &"
 
+    size_func = "message"
+
     @property
     def encode_func(self):
         return f"encode_message<{self.cpp_type}>"
@@ -353,6 +384,7 @@ class BytesType(TypeInfo):
     const_reference_type = "const std::string &"
     decode_length = "value.as_string()"
     encode_func = "encode_string"
+    size_func = "string"
 
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
@@ -365,6 +397,7 @@ class UInt32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_uint32()"
     encode_func = "encode_uint32"
+    size_func = "uint32"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRIu32, {name});\n'
@@ -384,6 +417,8 @@ class EnumType(TypeInfo):
 
     default_value = ""
 
+    size_func = "enum"
+
     @property
     def encode_func(self):
         return f"encode_enum<{self.cpp_type}>"
@@ -399,6 +434,7 @@ class SFixed32Type(TypeInfo):
     default_value = "0"
     decode_32bit = "value.as_sfixed32()"
     encode_func = "encode_sfixed32"
+    size_func = "sfixed32"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRId32, {name});\n'
@@ -412,6 +448,7 @@ class SFixed64Type(TypeInfo):
     default_value = "0"
     decode_64bit = "value.as_sfixed64()"
     encode_func = "encode_sfixed64"
+    size_func = "sfixed64"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
@@ -425,6 +462,7 @@ class SInt32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_sint32()"
     encode_func = "encode_sint32"
+    size_func = "sint32"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRId32, {name});\n'
@@ -438,6 +476,7 @@ class SInt64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_sint64()"
     encode_func = "encode_sint64"
+    size_func = "sint64"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
@@ -526,6 +565,13 @@ class RepeatedTypeInfo(TypeInfo):
         o += "}"
         return o
 
+    @property
+    def calculate_size_content(self) -> str:
+        o = f"for (const auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  {self._ti.get_size_calculation('it', True)}\n"
+        o += "}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -569,6 +615,7 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    calculate_size = []
     dump = []
 
     for field in desc.field:
@@ -579,6 +626,7 @@ def build_message_type(desc):
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        calculate_size.append(ti.calculate_size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -645,6 +693,18 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if calculate_size:
+        if len(calculate_size) == 1 and len(calculate_size[0]) + len(o) + 3 < 120:
+            o += f" {calculate_size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(calculate_size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120:
@@ -688,6 +748,7 @@ SOURCE_SERVER = 1
 SOURCE_CLIENT = 2
 
 RECEIVE_CASES = {}
+STATE_RESPONSE_IDS = {}
 
 ifdefs = {}
 
@@ -698,6 +759,18 @@ def get_opt(desc, opt, default=None):
     return desc.options.Extensions[opt]
 
 
+def is_entity_state_response(mt):
+    """Entity state updates are server messages named *StateResponse that carry the entity key."""
+    return (
+        mt.name.endswith("StateResponse")
+        and get_opt(mt, pb.source, 0) == SOURCE_SERVER
+        and any(
+            f.name == "key" and f.type == descriptor.FieldDescriptorProto.TYPE_FIXED32
+            for f in mt.field
+        )
+    )
+
+
 def build_service_message_type(mt):
     snake = camel_to_snake(mt.name)
     id_ = get_opt(mt, pb.id)
@@ -705,6 +778,8 @@ def build_service_message_type(mt):
         return None
 
     source = get_opt(mt, pb.source, 0)
+    if is_entity_state_response(mt):
+        STATE_RESPONSE_IDS[id_] = mt.name
 
     ifdef = get_opt(mt, pb.ifdef)
     log = get_opt(mt, pb.log, True)
@@ -858,6 +933,19 @@ def main():
         hpp += indent(hout) + "\n"
         cpp += cout
 
+    hpp += "  /// Whether the message type is an entity state update (one of the *StateResponse messages).\n"
+    hpp += "  static bool is_state_response(uint32_t msg_type);\n"
+    out = f"bool {class_name}::is_state_response(uint32_t msg_type) {{\n"
+    out += "  switch (msg_type) {\n"
+    for id_, name in sorted(STATE_RESPONSE_IDS.items()):
+        out += f"    case {id_}:  // {name}\n"
+    out += "      return true;\n"
+    out += "    default:\n"
+    out += "      return false;\n"
+    out += "  }\n"
+    out += "}\n"
+    cpp += out
+
     cases = list(RECEIVE_CASES.items())
     cases.sort()
     hpp += " protected:\n"